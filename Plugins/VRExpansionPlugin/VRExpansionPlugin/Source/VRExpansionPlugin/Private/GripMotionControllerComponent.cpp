@@ -18,6 +18,7 @@
 #include "DrawDebugHelpers.h"
 
 #include "VRBaseCharacter.h"
+#include "VRPoseFilterStage.h"
 
 #include "PhysicsPublic.h"
 #include "PhysicsEngine/BodySetup.h"
@@ -34,6 +35,9 @@
 DEFINE_LOG_CATEGORY(LogVRMotionController);
 //For UE4 Profiler ~ Stat
 DECLARE_CYCLE_STAT(TEXT("TickGrip ~ TickingGrip"), STAT_TickGrip, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TickGrip ~ Controller Net Sends"), STAT_TickGripNetSends, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TickGrip ~ Controllers Sending"), STAT_TickGripSendingControllers, STATGROUP_TickGrip);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("TickGrip ~ Controller Avg Send Rate (per controller)"), STAT_TickGripAvgSendRate, STATGROUP_TickGrip);
 
 // MAGIC NUMBERS
 // Constraint multipliers for angular, to avoid having to have two sets of stiffness/damping variables
@@ -91,6 +95,7 @@ UGripMotionControllerComponent::UGripMotionControllerComponent(const FObjectInit
 	bSmoothReplicatedMotion = false;
 	bReppedOnce = false;
 	bOffsetByHMD = false;
+	bUseSharedPoseFilter = false;
 	bIsPostTeleport = false;
 
 	GripIDIncrementer = 0;
@@ -1991,6 +1996,10 @@ bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip
 
 	}
 
+	// Restart the shared pose filter so the hand doesn't trail behind the grip snap
+	if (!bIsReInit && bUseSharedPoseFilter && IsLocallyControlled())
+		FVRPoseFilterStage::ResetControllerFilter(PlayerIndex, MotionSource);
+
 	if (!bIsReInit)
 	{
 		// Broadcast a new grip
@@ -2016,6 +2025,9 @@ void UGripMotionControllerComponent::NotifyDrop_Implementation(const FBPActorGri
 
 void UGripMotionControllerComponent::Drop_Implementation(const FBPActorGripInformation &NewDrop, bool bSimulate)
 {
+	// Restart the shared pose filter so the release happens from the unfiltered hand pose
+	if (bUseSharedPoseFilter && IsLocallyControlled())
+		FVRPoseFilterStage::ResetControllerFilter(PlayerIndex, MotionSource);
 
 	bool bSkipFullDrop = false;
 	UGripMotionControllerComponent * HoldingController = nullptr;
@@ -2801,7 +2813,14 @@ void UGripMotionControllerComponent::TickComponent(float DeltaTime, enum ELevelT
 			float WorldToMeters = GetWorld() ? GetWorld()->GetWorldSettings()->WorldToMeters : 100.0f;
 			const bool bNewTrackedState = GripPollControllerState(Position, Orientation, WorldToMeters);
 
-			if (bNewTrackedState)
+			bool bPoseMoved = true;
+			if (bNewTrackedState && bUseSharedPoseFilter)
+			{
+				FVRPoseFilterStage::FilterControllerPose(PlayerIndex, MotionSource, Position, Orientation, bPoseMoved);
+			}
+
+			// Skip the transform update when the filter is holding the last pose
+			if (bNewTrackedState && (bPoseMoved || !bTracked))
 			{
 				SetRelativeTransform(CurrentControllerProfileTransform * FTransform(Orientation, Position, this->RelativeScale3D));
 				SetRelativeLocationAndRotation(Position, Orientation);
@@ -2822,30 +2841,47 @@ void UGripMotionControllerComponent::TickComponent(float DeltaTime, enum ELevelT
 		// Don't bother with any of this if not replicating transform
 		if (bReplicates && (bTracked || bReplicateWithoutTracking))
 		{
+			bool bSendUpdate = false;
+
+			if (AdaptiveNetUpdate.bUseAdaptiveNetUpdate)
+			{
+				bSendUpdate = AdaptiveNetUpdate.ShouldSend(this->RelativeLocation, this->RelativeRotation, ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation, ControllerNetUpdateRate, DeltaTime);
+			}
 			// Don't rep if no changes
-			if (!this->RelativeLocation.Equals(ReplicatedControllerTransform.Position) || !this->RelativeRotation.Equals(ReplicatedControllerTransform.Rotation))
+			else if (!this->RelativeLocation.Equals(ReplicatedControllerTransform.Position) || !this->RelativeRotation.Equals(ReplicatedControllerTransform.Rotation))
 			{
 				ControllerNetUpdateCount += DeltaTime;
 				if (ControllerNetUpdateCount >= (1.0f / ControllerNetUpdateRate))
 				{
 					ControllerNetUpdateCount = 0.0f;
+					bSendUpdate = true;
+				}
+			}
 
-					// Tracked doesn't matter, already set the relative location above in that case
-					ReplicatedControllerTransform.Position = this->RelativeLocation;
-					ReplicatedControllerTransform.Rotation = this->RelativeRotation;
+			if (bSendUpdate)
+			{
+				INC_DWORD_STAT(STAT_TickGripNetSends);
 
-					if (GetNetMode() == NM_Client)
-					{		
-						AVRBaseCharacter * OwningChar = Cast<AVRBaseCharacter>(GetOwner());
-						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
-						{
-							(OwningChar->* (OverrideSendTransform))(ReplicatedControllerTransform);
-						}
-						else
-							Server_SendControllerTransform(ReplicatedControllerTransform);
+				// Tracked doesn't matter, already set the relative location above in that case
+				ReplicatedControllerTransform.Position = this->RelativeLocation;
+				ReplicatedControllerTransform.Rotation = this->RelativeRotation;
+
+				if (GetNetMode() == NM_Client)
+				{		
+					AVRBaseCharacter * OwningChar = Cast<AVRBaseCharacter>(GetOwner());
+					if (OverrideSendTransform != nullptr && OwningChar != nullptr)
+					{
+						(OwningChar->* (OverrideSendTransform))(ReplicatedControllerTransform);
 					}
+					else
+						Server_SendControllerTransform(ReplicatedControllerTransform);
 				}
 			}
+
+			AdaptiveNetUpdate.UpdateSendRate(bSendUpdate, DeltaTime);
+			INC_DWORD_STAT(STAT_TickGripSendingControllers);
+			static FVRAverageSendRateStat ControllerSendRateStat;
+			SET_FLOAT_STAT(STAT_TickGripAvgSendRate, ControllerSendRateStat.Add(AdaptiveNetUpdate.AverageSendRate));
 		}
 	}
 	else
@@ -4459,7 +4495,7 @@ bool UGripMotionControllerComponent::FGripViewExtension::IsActiveThisFrame(class
 	check(IsInGameThread());
 
 	static const auto CVarEnableMotionControllerLateUpdate = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("vr.EnableMotionControllerLateUpdate"));
-	return MotionControllerComponent && !MotionControllerComponent->bDisableLowLatencyUpdate && CVarEnableMotionControllerLateUpdate->GetValueOnGameThread();
+	return MotionControllerComponent && !MotionControllerComponent->bDisableLowLatencyUpdate && !MotionControllerComponent->bUseSharedPoseFilter && CVarEnableMotionControllerLateUpdate->GetValueOnGameThread();
 }
 
 void UGripMotionControllerComponent::GetAllGrips(TArray<FBPActorGripInformation> &GripArray)
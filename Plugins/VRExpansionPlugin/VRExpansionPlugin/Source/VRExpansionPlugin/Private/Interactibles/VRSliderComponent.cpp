@@ -38,6 +38,7 @@ UVRSliderComponent::UVRSliderComponent(const FObjectInitializer& ObjectInitializ
 	GripPriority = 1;
 	LastSliderProgressState = -1.0f;
 	LastInputKey = 0.0f;
+	SplineLookupSampleDistance = 2.0f;
 
 	bSliderUsesSnapPoints = false;
 	SnapIncrement = 0.1f;
@@ -108,7 +109,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 	if (SplineComponentToFollow != nullptr)
 	{
 		FVector WorldCalculatedLocation = CurrentRelativeTransform.TransformPosition(CalculatedLocation);
-		float ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(WorldCalculatedLocation);
+		float ClosestKey = FindSplineInputKeyClosestToWorldLocation(WorldCalculatedLocation);
 
 		if (bSliderUsesSnapPoints)
 		{
@@ -153,7 +154,8 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				trans = SplineComponentToFollow->FindTransformClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World, true);
+				// ClosestKey is already the closest key to WorldCalculatedLocation (or the snapped key it was moved to)
+				trans = SplineComponentToFollow->GetTransformAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World, true);
 				bChangedLocation = true;
 			}
 
@@ -175,7 +177,7 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 			}
 			else if (bLerpToNewKey)
 			{
-				WorldLocation = SplineComponentToFollow->FindLocationClosestToWorldLocation(WorldCalculatedLocation, ESplineCoordinateSpace::World);
+				WorldLocation = SplineComponentToFollow->GetLocationAtSplineInputKey(ClosestKey, ESplineCoordinateSpace::World);
 				bChangedLocation = true;
 			}
 
@@ -235,6 +237,132 @@ void UVRSliderComponent::TickGrip_Implementation(UGripMotionControllerComponent
 	}
 }
 
+void UVRSliderComponent::RebuildSplineLookup()
+{
+	SplineLookup.Reset();
+
+	if (SplineComponentToFollow == nullptr)
+		return;
+
+	const int32 NumPoints = SplineComponentToFollow->GetNumberOfSplinePoints();
+	const float SplineLength = SplineComponentToFollow->GetSplineLength();
+
+	SplineLookup.NumSplinePoints = NumPoints;
+	SplineLookup.SplineLength = SplineLength;
+	SplineLookup.bClosedLoop = SplineComponentToFollow->IsClosedLoop();
+
+	if (NumPoints < 2 || SplineLength <= KINDA_SMALL_NUMBER)
+		return;
+
+	// Uniform in arc length so that sample density doesn't depend on how the spline points are spaced
+	const int32 NumSamples = FMath::Clamp(FMath::CeilToInt(SplineLength / FMath::Max(SplineLookupSampleDistance, 0.1f)) + 1, 2, FVRSliderSplineLookup::MaxSamples);
+	const float SampleStep = SplineLength / (float)(NumSamples - 1);
+
+	SplineLookup.Positions.Reserve(NumSamples);
+	SplineLookup.Keys.Reserve(NumSamples);
+
+	for (int i = 0; i < NumSamples; i++)
+	{
+		float Key = SplineComponentToFollow->SplineCurves.ReparamTable.Eval(SampleStep * (float)i, 0.0f);
+		SplineLookup.Keys.Add(Key);
+		SplineLookup.Positions.Add(SplineComponentToFollow->GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local));
+	}
+
+	// Chunks overlap by one sample so that the segment between two chunks is inside of both bounds
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumSamples - 1, FVRSliderSplineLookup::SamplesPerChunk);
+	SplineLookup.ChunkBounds.Reserve(NumChunks);
+
+	for (int i = 0; i < NumChunks; i++)
+	{
+		const int32 Start = i * FVRSliderSplineLookup::SamplesPerChunk;
+		const int32 End = FMath::Min(Start + FVRSliderSplineLookup::SamplesPerChunk, NumSamples - 1);
+		SplineLookup.ChunkBounds.Add(FBox(&SplineLookup.Positions[Start], End - Start + 1));
+	}
+}
+
+float UVRSliderComponent::FindSplineInputKeyClosestToWorldLocation(const FVector & WorldLocation)
+{
+	if (SplineComponentToFollow == nullptr)
+		return 0.0f;
+
+	if (SplineLookup.NumSplinePoints != SplineComponentToFollow->GetNumberOfSplinePoints() ||
+		SplineLookup.bClosedLoop != SplineComponentToFollow->IsClosedLoop() ||
+		SplineLookup.SplineLength != SplineComponentToFollow->GetSplineLength())
+	{
+		RebuildSplineLookup();
+	}
+
+	if (!SplineLookup.IsValid())
+		return SplineComponentToFollow->FindInputKeyClosestToWorldLocation(WorldLocation);
+
+	// Same space that the spline itself searches in
+	const FVector LocalLocation = SplineComponentToFollow->GetComponentTransform().InverseTransformPosition(WorldLocation);
+	const TArray<FVector> & Positions = SplineLookup.Positions;
+	const int32 NumSamples = Positions.Num();
+
+	int32 BestSample = INDEX_NONE;
+	float BestDistSq = BIG_NUMBER;
+
+	// Warm start from the last result, while held the closest point rarely moves far between ticks
+	// This only tightens the bound for the chunk search below, so the result is still the global closest
+	if (LastInputKey >= 0.0f && SplineLookup.LastClosestSample != INDEX_NONE)
+	{
+		const int32 Start = FMath::Max(SplineLookup.LastClosestSample - FVRSliderSplineLookup::SamplesPerChunk, 0);
+		const int32 End = FMath::Min(SplineLookup.LastClosestSample + FVRSliderSplineLookup::SamplesPerChunk, NumSamples - 1);
+
+		for (int i = Start; i <= End; i++)
+		{
+			float DistSq = FVector::DistSquared(Positions[i], LocalLocation);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestSample = i;
+			}
+		}
+	}
+
+	for (int c = 0; c < SplineLookup.ChunkBounds.Num(); c++)
+	{
+		if (SplineLookup.ChunkBounds[c].ComputeSquaredDistanceToPoint(LocalLocation) >= BestDistSq)
+			continue;
+
+		const int32 Start = c * FVRSliderSplineLookup::SamplesPerChunk;
+		const int32 End = FMath::Min(Start + FVRSliderSplineLookup::SamplesPerChunk, NumSamples - 1);
+
+		for (int i = Start; i <= End; i++)
+		{
+			float DistSq = FVector::DistSquared(Positions[i], LocalLocation);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				BestSample = i;
+			}
+		}
+	}
+
+	SplineLookup.LastClosestSample = BestSample;
+
+	// Refine against the two sample segments touching the closest sample and interpolate the key along the closer one
+	float BestKey = SplineLookup.Keys[BestSample];
+	float BestSegmentDistSq = BIG_NUMBER;
+
+	for (int i = FMath::Max(BestSample - 1, 0); i < FMath::Min(BestSample + 1, NumSamples - 1); i++)
+	{
+		const FVector SegmentDir = Positions[i + 1] - Positions[i];
+		const float SegmentSizeSq = SegmentDir.SizeSquared();
+		const float Alpha = SegmentSizeSq > SMALL_NUMBER ? FMath::Clamp(FVector::DotProduct(LocalLocation - Positions[i], SegmentDir) / SegmentSizeSq, 0.0f, 1.0f) : 0.0f;
+
+		float DistSq = FVector::DistSquared(Positions[i] + SegmentDir * Alpha, LocalLocation);
+		if (DistSq < BestSegmentDistSq)
+		{
+			BestSegmentDistSq = DistSq;
+			BestKey = FMath::Lerp(SplineLookup.Keys[i], SplineLookup.Keys[i + 1], Alpha);
+		}
+	}
+
+	return BestKey;
+}
+
 void UVRSliderComponent::OnGrip_Implementation(UGripMotionControllerComponent * GrippingController, const FBPActorGripInformation & GripInformation) 
 {
 	FTransform CurrentRelativeTransform = InitialRelativeTransform * UVRInteractibleFunctionLibrary::Interactible_GetCurrentParentTransform(this);
@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRCharacterRepulsionManager.h"
+#include "VRCharacterMovementComponent.h"
+#include "VRRootComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("VR Character Repulsion Grid Update"), STAT_VRCharacterRepulsionUpdate, STATGROUP_VRCharacterRepulsion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Character Repulsion Members"), STAT_VRCharacterRepulsionMembers, STATGROUP_VRCharacterRepulsion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Character Repulsion Pairs Tested"), STAT_VRCharacterRepulsionPairsTested, STATGROUP_VRCharacterRepulsion);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Character Repulsion Pairs Pushed"), STAT_VRCharacterRepulsionPairsPushed, STATGROUP_VRCharacterRepulsion);
+
+TMap<UWorld*, FVRCharacterRepulsionManager> FVRCharacterRepulsionManager::WorldManagers;
+
+namespace VRCharacterRepulsion
+{
+	// Capsules push each other within this multiple of their combined radius, matches the physics body repulsion radius
+	static const float RangeScale = 1.2f;
+
+	// Only the forward half of the neighbourhood so each cell pair is visited once
+	static const FIntPoint NeighbourOffsets[] = { FIntPoint(1, 0), FIntPoint(-1, 1), FIntPoint(0, 1), FIntPoint(1, 1) };
+}
+
+FVRCharacterRepulsionManager & FVRCharacterRepulsionManager::Get(UWorld * World)
+{
+	return WorldManagers.FindOrAdd(World);
+}
+
+void FVRCharacterRepulsionManager::Unregister(UVRCharacterMovementComponent * MoveComp)
+{
+	if (!MoveComp || MoveComp->RepulsionGridIndex == INDEX_NONE)
+		return;
+
+	for (TMap<UWorld*, FVRCharacterRepulsionManager>::TIterator It(WorldManagers); It; ++It)
+	{
+		TArray<UVRCharacterMovementComponent*> & Members = It.Value().Members;
+		const int32 Index = MoveComp->RepulsionGridIndex;
+
+		if (Members.IsValidIndex(Index) && Members[Index] == MoveComp)
+		{
+			Members.RemoveAtSwap(Index, 1, false);
+			if (Members.IsValidIndex(Index))
+			{
+				Members[Index]->RepulsionGridIndex = Index;
+			}
+
+			// Results are re-gathered next frame
+			It.Value().LastUpdateFrame = 0;
+			MoveComp->RepulsionGridIndex = INDEX_NONE;
+
+			if (Members.Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
+			return;
+		}
+	}
+
+	MoveComp->RepulsionGridIndex = INDEX_NONE;
+}
+
+void FVRCharacterRepulsionManager::Register(UVRCharacterMovementComponent * MoveComp)
+{
+	if (!MoveComp || MoveComp->RepulsionGridIndex != INDEX_NONE)
+		return;
+
+	MoveComp->RepulsionGridIndex = Members.Add(MoveComp);
+	LastUpdateFrame = 0;
+}
+
+FVector FVRCharacterRepulsionManager::GetRepulsionVelocity(UVRCharacterMovementComponent * MoveComp)
+{
+	if (LastUpdateFrame != GFrameCounter)
+	{
+		UpdateRepulsion();
+		LastUpdateFrame = GFrameCounter;
+	}
+
+	const int32 Index = MoveComp->RepulsionGridIndex;
+	return Results.IsValidIndex(Index) ? Results[Index] : FVector::ZeroVector;
+}
+
+void FVRCharacterRepulsionManager::UpdateRepulsion()
+{
+	SCOPE_CYCLE_COUNTER(STAT_VRCharacterRepulsionUpdate);
+
+	const int32 NumMembers = Members.Num();
+	INC_DWORD_STAT_BY(STAT_VRCharacterRepulsionMembers, NumMembers);
+
+	PosX.SetNumUninitialized(NumMembers, false);
+	PosY.SetNumUninitialized(NumMembers, false);
+	MinZ.SetNumUninitialized(NumMembers, false);
+	MaxZ.SetNumUninitialized(NumMembers, false);
+	Radius.SetNumUninitialized(NumMembers, false);
+	Strength.SetNumUninitialized(NumMembers, false);
+
+	// Every result is rewritten each frame, including frames that end before the pair pass
+	Results.Reset();
+	Results.AddZeroed(NumMembers);
+
+	// Gather
+	float MaxRadius = 0.0f;
+	for (int i = 0; i < NumMembers; i++)
+	{
+		UVRCharacterMovementComponent * MoveComp = Members[i];
+		ACharacter * CharOwner = MoveComp->GetCharacterOwner();
+
+		if (!MoveComp->UpdatedComponent || !CharOwner || !CharOwner->GetCapsuleComponent())
+		{
+			// Zero radius never pushes or gets pushed
+			PosX[i] = PosY[i] = MinZ[i] = MaxZ[i] = Radius[i] = Strength[i] = 0.0f;
+			continue;
+		}
+
+		float CapsuleRadius, CapsuleHalfHeight;
+		CharOwner->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+		const FVector Location = MoveComp->VRRootCapsule ? MoveComp->VRRootCapsule->OffsetComponentToWorld.GetLocation() : MoveComp->UpdatedComponent->GetComponentLocation();
+		PosX[i] = Location.X;
+		PosY[i] = Location.Y;
+		MinZ[i] = Location.Z - CapsuleHalfHeight;
+		MaxZ[i] = Location.Z + CapsuleHalfHeight;
+		Radius[i] = CapsuleRadius;
+		Strength[i] = MoveComp->CharacterRepulsionStrength;
+		MaxRadius = FMath::Max(MaxRadius, CapsuleRadius);
+	}
+
+	if (NumMembers < 2 || MaxRadius <= 0.0f)
+		return;
+
+	CalculatePushes(MaxRadius);
+}
+
+void FVRCharacterRepulsionManager::CalculatePushes(float MaxRadius)
+{
+	const int32 NumMembers = PosX.Num();
+
+	// Bin, cells are the largest possible interaction range so only neighbouring cells need testing
+	const float CellSize = MaxRadius * 2.0f * VRCharacterRepulsion::RangeScale;
+	const float InvCellSize = 1.0f / CellSize;
+
+	Grid.Reset();
+	for (int i = 0; i < NumMembers; i++)
+	{
+		if (Radius[i] <= 0.0f)
+			continue;
+
+		Grid.FindOrAdd(FIntPoint(FMath::FloorToInt(PosX[i] * InvCellSize), FMath::FloorToInt(PosY[i] * InvCellSize))).Add(i);
+	}
+
+	int32 PairsTested = 0;
+	int32 PairsPushed = 0;
+
+	auto TestPair = [&](int32 i, int32 j)
+	{
+		++PairsTested;
+
+		// Capsules have to share some height to push each other
+		if (MinZ[i] >= MaxZ[j] || MinZ[j] >= MaxZ[i])
+			return;
+
+		const float DX = PosX[j] - PosX[i];
+		const float DY = PosY[j] - PosY[i];
+		const float Range = (Radius[i] + Radius[j]) * VRCharacterRepulsion::RangeScale;
+		const float DistSq = DX * DX + DY * DY;
+
+		if (DistSq >= Range * Range)
+			return;
+
+		++PairsPushed;
+
+		float DirX = 1.0f;
+		float DirY = 0.0f;
+		const float Dist = FMath::Sqrt(DistSq);
+
+		// Exactly on top of each other, push apart along X (by index order so both sides agree)
+		if (Dist > KINDA_SMALL_NUMBER)
+		{
+			DirX = DX / Dist;
+			DirY = DY / Dist;
+		}
+
+		const float Falloff = 1.0f - (Dist / Range);
+
+		Results[i].X -= DirX * Falloff * Strength[i];
+		Results[i].Y -= DirY * Falloff * Strength[i];
+		Results[j].X += DirX * Falloff * Strength[j];
+		Results[j].Y += DirY * Falloff * Strength[j];
+	};
+
+	for (const TPair<FIntPoint, TArray<int32>> & Cell : Grid)
+	{
+		const TArray<int32> & CellMembers = Cell.Value;
+
+		// Within the cell
+		for (int a = 0; a < CellMembers.Num(); a++)
+		{
+			for (int b = a + 1; b < CellMembers.Num(); b++)
+			{
+				TestPair(CellMembers[a], CellMembers[b]);
+			}
+		}
+
+		// Against the forward neighbours
+		for (const FIntPoint & Offset : VRCharacterRepulsion::NeighbourOffsets)
+		{
+			const TArray<int32> * NeighbourMembers = Grid.Find(Cell.Key + Offset);
+			if (!NeighbourMembers)
+				continue;
+
+			for (int a = 0; a < CellMembers.Num(); a++)
+			{
+				for (int b = 0; b < NeighbourMembers->Num(); b++)
+				{
+					TestPair(CellMembers[a], (*NeighbourMembers)[b]);
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_VRCharacterRepulsionPairsTested, PairsTested);
+	INC_DWORD_STAT_BY(STAT_VRCharacterRepulsionPairsPushed, PairsPushed);
+}
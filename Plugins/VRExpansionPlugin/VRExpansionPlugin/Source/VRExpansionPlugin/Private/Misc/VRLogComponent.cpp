@@ -6,6 +6,15 @@
 /* Top of File */
 #define LOCTEXT_NAMESPACE "VRLogComponent" 
 
+// Number of lines back from the newest that the output log view starts at
+static int32 GetOutputLogScrollPos(int32 NumMessages, float ScrollOffset)
+{
+	if (ScrollOffset > 0 && NumMessages > 1)
+		return FMath::Clamp(FMath::RoundToInt(NumMessages * ScrollOffset), 0, NumMessages - 1);
+
+	return 0;
+}
+
   //=============================================================================
 UVRLogComponent::UVRLogComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -13,6 +22,10 @@ UVRLogComponent::UVRLogComponent(const FObjectInitializer& ObjectInitializer)
 	PrimaryComponentTick.bCanEverTick = false;
 	MaxLineLength = 130;
 	MaxStoredMessages = 10000;
+	MinOutputLogRedrawInterval = 0.0f;
+
+	LastOutputLogScrollPos = INDEX_NONE;
+	LastOutputLogDrawTime = 0.0f;
 }
 
 //=============================================================================
@@ -66,18 +79,33 @@ void UVRLogComponent::AppendTextToConsole(FString Text, bool bReturnAtEnd)
 
 bool UVRLogComponent::DrawConsoleToRenderTarget2D(EBPVRConsoleDrawType DrawType, UTextureRenderTarget2D * Texture, float ScrollOffset, bool bForceDraw)
 {
-	if (!bForceDraw && DrawType == EBPVRConsoleDrawType::VRConsole_Draw_OutputLogOnly && !OutputLogHistory.bIsDirty)
-	{
-		return false;
-	}
 	//LastRenderedOutputLogSize 
 
 //	check(WorldContextObject);
 	UWorld* World = GetWorld();//GEngine->GetWorldFromContextObject(WorldContextObject, false);
 
-	if (!World)
+	if (!World || !Texture)
 		return false;
 
+	if (DrawType == EBPVRConsoleDrawType::VRConsole_Draw_OutputLogOnly)
+	{
+		const int32 ScrollPos = GetOutputLogScrollPos(OutputLogHistory.Num(), ScrollOffset);
+
+		if (!bForceDraw)
+		{
+			// Only redraw if new lines came in or the visible window moved
+			if (!OutputLogHistory.bIsDirty && ScrollPos == LastOutputLogScrollPos && LastOutputLogTexture.Get() == Texture)
+				return false;
+
+			if (MinOutputLogRedrawInterval > 0.0f && (World->GetRealTimeSeconds() - LastOutputLogDrawTime) < MinOutputLogRedrawInterval)
+				return false;
+		}
+
+		LastOutputLogScrollPos = ScrollPos;
+		LastOutputLogTexture = Texture;
+		LastOutputLogDrawTime = World->GetRealTimeSeconds();
+	}
+
 	// Create or find the canvas object to use to render onto the texture.  Multiple canvas render target textures can share the same canvas.
 	UCanvas* Canvas = World->GetCanvasForRenderingToTarget();
 
@@ -163,18 +191,17 @@ void UVRLogComponent::DrawOutputLog(bool bUpperHalf, UCanvas* Canvas, float Scro
 
 	FCanvasTextItem ConsoleText(FVector2D(0, 0 + Height - 5 - yl), FText::FromString(TEXT("")), Font, FColor::Emerald);
 
-	const TArray< TSharedPtr<FVRLogMessage> > LoggedMessages = OutputLogHistory.GetMessages();
-	
-	int32 ScrollPos = 0;
-
-	if(ScrollOffset > 0 && LoggedMessages.Num() > 1)
-		ScrollPos = FMath::Clamp(FMath::RoundToInt(LoggedMessages.Num() * ScrollOffset ) , 0, LoggedMessages.Num() - 1);
+	// Only walks the lines that fit in the visible window, the text for each line is cached on the message after its first draw
+	const int32 NumMessages = OutputLogHistory.Num();
+	int32 ScrollPos = GetOutputLogScrollPos(NumMessages, ScrollOffset);
 
 	float Xpos = 0.0f;
 	float Ypos = 0.0f;
-	for (int i = LoggedMessages.Num() - (1 + ScrollPos); i >= 0 && Ypos <= Height - yl; i--)//auto &Message : LoggedMessages)
+	for (int i = NumMessages - (1 + ScrollPos); i >= 0 && Ypos <= Height - yl; i--)//auto &Message : LoggedMessages)
 	{
-		switch (LoggedMessages[i]->Verbosity)
+		const TSharedPtr<FVRLogMessage> & LoggedMessage = OutputLogHistory.GetMessage(i);
+
+		switch (LoggedMessage->Verbosity)
 		{
 
 		case ELogVerbosity::Error:
@@ -186,7 +213,7 @@ void UVRLogComponent::DrawOutputLog(bool bUpperHalf, UCanvas* Canvas, float Scro
 		}
 
 		Ypos += yl;
-		ConsoleText.Text = FText::Format(NSLOCTEXT("VRLogComponent", "ConsoleFormat", "{0}"), FText::FromString(*LoggedMessages[i]->Message));
+		ConsoleText.Text = LoggedMessage->GetDisplayText();
 		Canvas->DrawItem(ConsoleText, 0, Height - Ypos);
 	}
 
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VRPoseFilterStage.h"
+#include "Engine/Engine.h"
+#include "IXRTrackingSystem.h"
+#include "Misc/App.h"
+#include "VRGlobalSettings.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRPoseFilter Devices Filtered"), STAT_VRPoseFilterDevicesFiltered, STATGROUP_VRPoseFilter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRPoseFilter Poses Held"), STAT_VRPoseFilterPosesHeld, STATGROUP_VRPoseFilter);
+
+namespace VRPoseFilterStage
+{
+	// If a device hasn't been filtered for this long then its filter is restarted instead of filtering across the gap
+	static const double MaxFilterGap = 0.25;
+
+	struct FDeviceState
+	{
+		FVRPoseFilter Filter;
+		uint64 LastFrame;
+		double LastTime;
+		FVector Position;
+		FQuat Orientation;
+		bool bMoved;
+
+		FDeviceState() :
+			LastFrame(0),
+			LastTime(0.0),
+			Position(FVector::ZeroVector),
+			Orientation(FQuat::Identity),
+			bMoved(false)
+		{}
+	};
+
+	typedef TPair<int32, FName> FDeviceKey;
+
+	static TMap<FDeviceKey, FDeviceState> DeviceStates;
+	static const FName HMDDeviceName(TEXT("HMD"));
+
+	// Runs the filter for the device if it hasn't been run yet this frame
+	static FDeviceState & FilterDevice(const FDeviceKey & Key, const FBPVRPoseFilterSettings & Settings, const FVector & RawPosition, const FQuat & RawOrientation)
+	{
+		FDeviceState & State = DeviceStates.FindOrAdd(Key);
+
+		if (State.LastFrame == GFrameCounter && State.LastTime > 0.0)
+			return State;
+
+		const double CurrentTime = FApp::GetCurrentTime();
+		if (State.LastTime <= 0.0 || CurrentTime - State.LastTime > MaxFilterGap)
+		{
+			State.Filter.Reset();
+		}
+
+		State.bMoved = State.Filter.Filter(Settings, RawPosition, RawOrientation, (float)(CurrentTime - State.LastTime), State.Position, State.Orientation);
+		State.LastFrame = GFrameCounter;
+		State.LastTime = CurrentTime;
+
+		INC_DWORD_STAT(STAT_VRPoseFilterDevicesFiltered);
+		if (!State.bMoved)
+		{
+			INC_DWORD_STAT(STAT_VRPoseFilterPosesHeld);
+		}
+
+		return State;
+	}
+}
+
+bool FVRPoseFilterStage::GetFilteredHMDPose(FQuat & OutOrientation, FVector & OutPosition, bool & bOutMoved)
+{
+	check(IsInGameThread());
+
+	const VRPoseFilterStage::FDeviceKey Key(IXRTrackingSystem::HMDDeviceId, VRPoseFilterStage::HMDDeviceName);
+
+	// Already filtered this frame, skip polling the device again
+	if (VRPoseFilterStage::FDeviceState * State = VRPoseFilterStage::DeviceStates.Find(Key))
+	{
+		if (State->LastFrame == GFrameCounter && State->LastTime > 0.0)
+		{
+			OutOrientation = State->Orientation;
+			OutPosition = State->Position;
+			bOutMoved = State->bMoved;
+			return true;
+		}
+	}
+
+	FQuat RawOrientation;
+	FVector RawPosition;
+	if (!GEngine || !GEngine->XRSystem.IsValid() || !GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, RawOrientation, RawPosition))
+	{
+		bOutMoved = false;
+		return false;
+	}
+
+	const UVRGlobalSettings& VRSettings = *GetDefault<UVRGlobalSettings>();
+	const VRPoseFilterStage::FDeviceState & State = VRPoseFilterStage::FilterDevice(Key, VRSettings.HMDPoseFilterSettings, RawPosition, RawOrientation);
+
+	OutOrientation = State.Orientation;
+	OutPosition = State.Position;
+	bOutMoved = State.bMoved;
+	return true;
+}
+
+void FVRPoseFilterStage::FilterControllerPose(int32 PlayerIndex, FName MotionSource, FVector & InOutPosition, FRotator & InOutOrientation, bool & bOutMoved)
+{
+	check(IsInGameThread());
+
+	const UVRGlobalSettings& VRSettings = *GetDefault<UVRGlobalSettings>();
+	const VRPoseFilterStage::FDeviceState & State = VRPoseFilterStage::FilterDevice(VRPoseFilterStage::FDeviceKey(PlayerIndex, MotionSource), VRSettings.ControllerPoseFilterSettings, InOutPosition, InOutOrientation.Quaternion());
+
+	InOutPosition = State.Position;
+	InOutOrientation = State.Orientation.Rotator();
+	bOutMoved = State.bMoved;
+}
+
+void FVRPoseFilterStage::ResetFilters()
+{
+	VRPoseFilterStage::DeviceStates.Empty();
+}
+
+void FVRPoseFilterStage::ResetControllerFilter(int32 PlayerIndex, FName MotionSource)
+{
+	VRPoseFilterStage::DeviceStates.Remove(VRPoseFilterStage::FDeviceKey(PlayerIndex, MotionSource));
+}
@@ -28,10 +28,59 @@ UParentRelativeAttachmentComponent::UParentRelativeAttachmentComponent(const FOb
 	bWasSetOnce = false;
 
 	bIgnoreRotationFromParent = false;
+
+	YawUpdateThreshold = 0.0f;
+	LastSourceYaw = 0.0f;
+	LastCalculatedRotation = FQuat::Identity;
+	bHasCalculatedRotation = false;
+	CachedOwnerComponentCount = 0;
+	bOwnerCacheDirty = true;
+}
+
+void UParentRelativeAttachmentComponent::RefreshOwnerCache()
+{
+	AActor * MyOwner = GetOwner();
+	CachedVRCharacter = Cast<AVRCharacter>(MyOwner);
+	CachedCamera = (MyOwner && !CachedVRCharacter.IsValid()) ? MyOwner->FindComponentByClass<UCameraComponent>() : nullptr;
+	CachedOwnerComponentCount = MyOwner ? MyOwner->GetComponents().Num() : 0;
+	bOwnerCacheDirty = false;
+}
+
+bool UParentRelativeAttachmentComponent::NeedsOwnerCacheRefresh() const
+{
+	if (bOwnerCacheDirty || CachedCamera.IsStale() || (CachedCamera.IsValid() && !CachedCamera->IsRegistered()))
+		return true;
+
+	const AActor * MyOwner = GetOwner();
+	return MyOwner && MyOwner->GetComponents().Num() != CachedOwnerComponentCount;
+}
+
+void UParentRelativeAttachmentComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	RefreshOwnerCache();
+}
+
+void UParentRelativeAttachmentComponent::OnRegister()
+{
+	Super::OnRegister();
+	bOwnerCacheDirty = true;
+}
+
+void UParentRelativeAttachmentComponent::OnAttachmentChanged()
+{
+	Super::OnAttachmentChanged();
+	bOwnerCacheDirty = true;
 }
 
 void UParentRelativeAttachmentComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	// Re-resolve if flagged, if the owner gained or lost components, or if the cached camera was destroyed
+	if (NeedsOwnerCacheRefresh())
+	{
+		RefreshOwnerCache();
+	}
+
 	if (OptionalWaistTrackingParent.IsValid())
 	{
 		//#TODO: bOffsetByHMD not supported with this currently, fix it, need to check for both camera and HMD
@@ -52,9 +101,18 @@ void UParentRelativeAttachmentComponent::TickComponent(float DeltaTime, enum ELe
 		SetRelativeTransform(TrackedParentWaist);
 
 	}
-	else if (AVRCharacter * CharacterOwner = Cast<AVRCharacter>(this->GetOwner())) // New case to early out and with less calculations
-	{		
-		SetRelativeRotAndLoc(CharacterOwner->VRRootReference->curCameraLoc, CharacterOwner->VRRootReference->StoredCameraRotOffset, DeltaTime);
+	else if (AVRCharacter * CharacterOwner = CachedVRCharacter.Get()) // New case to early out and with less calculations
+	{
+		const float SourceYaw = CharacterOwner->VRRootReference->StoredCameraRotOffset.Yaw;
+		if (!bIgnoreRotationFromParent && CanSkipYawUpdate(SourceYaw))
+		{
+			SetRelativeLocWithLastRot(CharacterOwner->VRRootReference->curCameraLoc);
+		}
+		else
+		{
+			LastSourceYaw = SourceYaw;
+			SetRelativeRotAndLoc(CharacterOwner->VRRootReference->curCameraLoc, CharacterOwner->VRRootReference->StoredCameraRotOffset, DeltaTime);
+		}
 	}
 	else if (IsLocallyControlled() && GEngine->XRSystem.IsValid() && GEngine->XRSystem->IsHeadTrackingAllowed())
 	{
@@ -70,21 +128,38 @@ void UParentRelativeAttachmentComponent::TickComponent(float DeltaTime, enum ELe
 			
 			if (!bIgnoreRotationFromParent)
 			{
-				FRotator InverseRot = UVRExpansionFunctionLibrary::GetHMDPureYaw_I(curRot.Rotator());
-				SetRelativeRotAndLoc(curCameraLoc, InverseRot, DeltaTime);
+				const FRotator CurRotator = curRot.Rotator();
+				if (CanSkipYawUpdate(CurRotator.Yaw))
+				{
+					SetRelativeLocWithLastRot(curCameraLoc);
+				}
+				else
+				{
+					LastSourceYaw = CurRotator.Yaw;
+					FRotator InverseRot = UVRExpansionFunctionLibrary::GetHMDPureYaw_I(CurRotator);
+					SetRelativeRotAndLoc(curCameraLoc, InverseRot, DeltaTime);
+				}
 			}
 			else
 				SetRelativeRotAndLoc(curCameraLoc, FRotator::ZeroRotator, DeltaTime);
 		}
 	}
-	else if (AActor * owner = this->GetOwner())
+	else
 	{
-		if (UCameraComponent * CameraOwner = owner->FindComponentByClass<UCameraComponent>())
+		if (UCameraComponent * CameraOwner = CachedCamera.Get())
 		{
 			if (!bIgnoreRotationFromParent)
 			{
-				FRotator InverseRot = UVRExpansionFunctionLibrary::GetHMDPureYaw(CameraOwner->RelativeRotation);
-				SetRelativeRotAndLoc(CameraOwner->RelativeLocation, InverseRot, DeltaTime);
+				if (CanSkipYawUpdate(CameraOwner->RelativeRotation.Yaw))
+				{
+					SetRelativeLocWithLastRot(CameraOwner->RelativeLocation);
+				}
+				else
+				{
+					LastSourceYaw = CameraOwner->RelativeRotation.Yaw;
+					FRotator InverseRot = UVRExpansionFunctionLibrary::GetHMDPureYaw(CameraOwner->RelativeRotation);
+					SetRelativeRotAndLoc(CameraOwner->RelativeLocation, InverseRot, DeltaTime);
+				}
 			}
 			else
 				SetRelativeRotAndLoc(CameraOwner->RelativeLocation, FRotator::ZeroRotator, DeltaTime);
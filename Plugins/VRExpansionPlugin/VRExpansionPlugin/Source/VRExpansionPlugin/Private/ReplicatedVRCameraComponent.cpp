@@ -7,6 +7,11 @@
 #include "IXRCamera.h"
 #include "VRBaseCharacter.h"
 #include "IHeadMountedDisplay.h"
+#include "VRPoseFilterStage.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Net Sends"), STAT_ReplicatedVRCameraNetSends, STATGROUP_ReplicatedVRCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cameras Sending"), STAT_ReplicatedVRCameraSendingCameras, STATGROUP_ReplicatedVRCamera);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Camera Avg Send Rate (per camera)"), STAT_ReplicatedVRCameraAvgSendRate, STATGROUP_ReplicatedVRCamera);
 
 
 UReplicatedVRCameraComponent::UReplicatedVRCameraComponent(const FObjectInitializer& ObjectInitializer)
@@ -26,6 +31,7 @@ UReplicatedVRCameraComponent::UReplicatedVRCameraComponent(const FObjectInitiali
 	bUsePawnControlRotation = false;
 	bAutoSetLockToHmd = true;
 	bOffsetByHMD = false;
+	bUseSharedPoseFilter = false;
 
 	bSetPositionDuringTick = false;
 	bSmoothReplicatedMotion = false;
@@ -121,7 +127,8 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 			//ResetRelativeTransform();
 			FQuat Orientation;
 			FVector Position;
-			if (GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, Orientation, Position))
+			bool bPoseMoved = true;
+			if (bUseSharedPoseFilter ? FVRPoseFilterStage::GetFilteredHMDPose(Orientation, Position, bPoseMoved) : GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, Orientation, Position))
 			{
 				if (bOffsetByHMD)
 				{
@@ -129,41 +136,82 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 					Position.Y = 0;
 				}
 
-				SetRelativeTransform(FTransform(Orientation, Position));
+				// Filter is holding the last pose, nothing to update
+				if (bPoseMoved)
+					SetRelativeTransform(FTransform(Orientation, Position));
 			}
 		}
 
 		// Send changes
 		if (bReplicates)
 		{
+			FVector SendPosition = this->RelativeLocation;
+			FRotator SendRotation = this->RelativeRotation;
+
+			// The view sets the relative transform from the raw pose, send the filtered one instead
+			if (bUseSharedPoseFilter && GEngine->XRSystem.IsValid() && GEngine->XRSystem->IsHeadTrackingAllowed())
+			{
+				FQuat FilteredOrientation;
+				FVector FilteredPosition;
+				bool bPoseMoved = true;
+				if (FVRPoseFilterStage::GetFilteredHMDPose(FilteredOrientation, FilteredPosition, bPoseMoved))
+				{
+					if (bOffsetByHMD)
+					{
+						FilteredPosition.X = 0;
+						FilteredPosition.Y = 0;
+					}
+
+					SendPosition = FilteredPosition;
+					SendRotation = FilteredOrientation.Rotator();
+				}
+			}
+
+			bool bSendUpdate = false;
+
+			if (AdaptiveNetUpdate.bUseAdaptiveNetUpdate)
+			{
+				bSendUpdate = AdaptiveNetUpdate.ShouldSend(SendPosition, SendRotation, ReplicatedCameraTransform.Position, ReplicatedCameraTransform.Rotation, NetUpdateRate, DeltaTime);
+			}
 			// Don't rep if no changes
-			if (!this->RelativeLocation.Equals(ReplicatedCameraTransform.Position) ||  !this->RelativeRotation.Equals(ReplicatedCameraTransform.Rotation))
+			else if (!SendPosition.Equals(ReplicatedCameraTransform.Position) || !SendRotation.Equals(ReplicatedCameraTransform.Rotation))
 			{
 				NetUpdateCount += DeltaTime;
 
 				if (NetUpdateCount >= (1.0f / NetUpdateRate))
 				{
 					NetUpdateCount = 0.0f;
-					ReplicatedCameraTransform.Position = this->RelativeLocation;
-					ReplicatedCameraTransform.Rotation = this->RelativeRotation;
+					bSendUpdate = true;
+				}
+			}
 
+			if (bSendUpdate)
+			{
+				INC_DWORD_STAT(STAT_ReplicatedVRCameraNetSends);
 
-					if (GetNetMode() == NM_Client)
+				ReplicatedCameraTransform.Position = SendPosition;
+				ReplicatedCameraTransform.Rotation = SendRotation;
+
+				if (GetNetMode() == NM_Client)
+				{
+					AVRBaseCharacter * OwningChar = Cast<AVRBaseCharacter>(GetOwner());
+					if (OverrideSendTransform != nullptr && OwningChar != nullptr)
 					{
-						AVRBaseCharacter * OwningChar = Cast<AVRBaseCharacter>(GetOwner());
-						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
-						{
-							(OwningChar->* (OverrideSendTransform))(ReplicatedCameraTransform);
-						}
-						else
-						{
-							// Don't bother with any of this if not replicating transform
-							//if (bHasAuthority && bReplicateTransform)
-							Server_SendCameraTransform(ReplicatedCameraTransform);
-						}
+						(OwningChar->* (OverrideSendTransform))(ReplicatedCameraTransform);
+					}
+					else
+					{
+						// Don't bother with any of this if not replicating transform
+						//if (bHasAuthority && bReplicateTransform)
+						Server_SendCameraTransform(ReplicatedCameraTransform);
 					}
 				}
 			}
+
+			AdaptiveNetUpdate.UpdateSendRate(bSendUpdate, DeltaTime);
+			INC_DWORD_STAT(STAT_ReplicatedVRCameraSendingCameras);
+			static FVRAverageSendRateStat CameraSendRateStat;
+			SET_FLOAT_STAT(STAT_ReplicatedVRCameraAvgSendRate, CameraSendRateStat.Add(AdaptiveNetUpdate.AverageSendRate));
 		}
 	}
 	else
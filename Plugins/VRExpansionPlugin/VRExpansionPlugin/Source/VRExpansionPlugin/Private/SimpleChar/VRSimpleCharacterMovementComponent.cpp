@@ -32,6 +32,8 @@ DEFINE_LOG_CATEGORY(LogSimpleCharacterMovement);
 
 DECLARE_CYCLE_STAT(TEXT("Char ReplicateMoveToServerVRSimple"), STAT_CharacterMovementReplicateMoveToServerVRSimple, STATGROUP_Character);
 DECLARE_CYCLE_STAT(TEXT("Char CallServerMoveVRSimple"), STAT_CharacterMovementCallServerMoveVRSimple, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRSimple Floor Cache Hits"), STAT_VRSimpleFloorCacheHits, STATGROUP_VRSimpleCharacterMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRSimple Floor Cache Misses"), STAT_VRSimpleFloorCacheMisses, STATGROUP_VRSimpleCharacterMovement);
 
 
 //#include "PerfCountersHelpers.h"
@@ -58,6 +60,8 @@ UVRSimpleCharacterMovementComponent::UVRSimpleCharacterMovementComponent(const F
 	this->AirControl = 0.0f;
 
 	bSkipHMDChecks = false;
+	bUseFloorResultCache = false;
+	FloorCacheTolerance = 1.0f;
 	bIsFirstTick = true;
 	//LastAdditionalVRInputVector = FVector::ZeroVector;
 	AdditionalVRInputVector = FVector::ZeroVector;	
@@ -66,6 +70,84 @@ UVRSimpleCharacterMovementComponent::UVRSimpleCharacterMovementComponent(const F
 	//bMaintainHorizontalGroundVelocity = true;
 }
 
+void UVRSimpleCharacterMovementComponent::FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bZeroDelta, const FHitResult* DownwardSweepResult) const
+{
+	if (!bUseFloorResultCache || !CharacterOwner || !CharacterOwner->GetCapsuleComponent())
+	{
+		Super::FindFloor(CapsuleLocation, OutFloorResult, bZeroDelta, DownwardSweepResult);
+		return;
+	}
+
+	float CapsuleRadius, CapsuleHalfHeight;
+	CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	// Sweep results passed in are cheaper than the cache check, teleports and forced checks always re-run
+	if (!DownwardSweepResult && !bForceNextFloorCheck && !bJustTeleported && FloorResultCache.bIsValid)
+	{
+		const FVRSimpleFloorResultCache & Cache = FloorResultCache;
+		UPrimitiveComponent * FloorPrim = Cache.FloorPrimitive.Get();
+
+		// Capsule footprint has to stay inside of the floor, otherwise it may be stepping over a ledge
+		const FBox FloorBounds = FloorPrim ? FloorPrim->Bounds.GetBox() : FBox(ForceInit);
+		const bool bInsideFloorBounds = FloorPrim &&
+			CapsuleLocation.X - CapsuleRadius >= FloorBounds.Min.X && CapsuleLocation.X + CapsuleRadius <= FloorBounds.Max.X &&
+			CapsuleLocation.Y - CapsuleRadius >= FloorBounds.Min.Y && CapsuleLocation.Y + CapsuleRadius <= FloorBounds.Max.Y;
+
+		if (bInsideFloorBounds &&
+			Cache.FrameNumber == GFrameCounter &&
+			FloorPrim->Mobility == Cache.FloorMobility &&
+			(Cache.FloorMobility == EComponentMobility::Static || FloorPrim->GetComponentTransform().Equals(Cache.FloorTransform, 0.0f)) &&
+			FMath::IsNearlyEqual(CapsuleLocation.Z, Cache.CapsuleLocation.Z, KINDA_SMALL_NUMBER) &&
+			FVector::DistSquared2D(CapsuleLocation, Cache.CapsuleLocation) <= FMath::Square(FloorCacheTolerance) &&
+			CapsuleRadius == Cache.CapsuleRadius && CapsuleHalfHeight == Cache.CapsuleHalfHeight)
+		{
+			INC_DWORD_STAT(STAT_VRSimpleFloorCacheHits);
+			FloorResultCache.NumHits++;
+			OutFloorResult = Cache.FloorResult;
+			return;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_VRSimpleFloorCacheMisses);
+	FloorResultCache.NumMisses++;
+	Super::FindFloor(CapsuleLocation, OutFloorResult, bZeroDelta, DownwardSweepResult);
+
+	// Only cache walkable flat floors, on a slope the floor distance changes with horizontal movement
+	UPrimitiveComponent * HitPrim = OutFloorResult.HitResult.Component.Get();
+	if (OutFloorResult.IsWalkableFloor() && HitPrim && !OutFloorResult.HitResult.bStartPenetrating && OutFloorResult.HitResult.ImpactNormal.Z >= (1.0f - KINDA_SMALL_NUMBER))
+	{
+		FloorResultCache.FloorResult = OutFloorResult;
+		FloorResultCache.CapsuleLocation = CapsuleLocation;
+		FloorResultCache.CapsuleRadius = CapsuleRadius;
+		FloorResultCache.CapsuleHalfHeight = CapsuleHalfHeight;
+		FloorResultCache.FloorPrimitive = HitPrim;
+		FloorResultCache.FloorMobility = HitPrim->Mobility;
+		FloorResultCache.FloorTransform = HitPrim->GetComponentTransform();
+		FloorResultCache.FrameNumber = GFrameCounter;
+		FloorResultCache.bIsValid = true;
+	}
+	else
+	{
+		FloorResultCache.Invalidate();
+	}
+}
+
+bool UVRSimpleCharacterMovementComponent::MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
+{
+	if (!bUseFloorResultCache || !FloorResultCache.bIsValid)
+		return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+
+	// Need the hit even if the caller doesn't, anything blocking the move may have changed the floor under us
+	FHitResult LocalHit;
+	FHitResult * Hit = OutHit ? OutHit : &LocalHit;
+	const bool bMoved = Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, Hit, Teleport);
+
+	if (Hit->bBlockingHit)
+		FloorResultCache.Invalidate();
+
+	return bMoved;
+}
+
 bool UVRSimpleCharacterMovementComponent::VRClimbStepUp(const FVector& GravDir, const FVector& Delta, const FHitResult &InHit, FStepDownResult* OutStepDownResult)
 {
 	//SCOPE_CYCLE_COUNTER(STAT_CharStepUp);
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "ParentRelativeAttachmentComponent.h"
+#include "Camera/CameraComponent.h"
+#include "VRExpansionTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParentRelativeAttachmentBenchmark, "VRExpansion.ParentRelativeAttachment.Tick200Pawns", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParentRelativeAttachmentRuntimeCameraTest, "VRExpansion.ParentRelativeAttachment.PicksUpRuntimeCamera", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace ParentRelativeAttachmentTests
+{
+	static const FVector CameraLocation(12.0f, -4.0f, 170.0f);
+
+	// Adds a registered camera to the actor, the same way a blueprint would add one at runtime
+	static UCameraComponent * AddCamera(AActor * Owner)
+	{
+		UCameraComponent * Camera = NewObject<UCameraComponent>(Owner);
+		Camera->SetupAttachment(Owner->GetRootComponent());
+		Camera->SetRelativeLocationAndRotation(CameraLocation, FRotator(0.0f, 45.0f, 0.0f));
+		Camera->RegisterComponent();
+		return Camera;
+	}
+
+	// Spawns an actor with a scene root and a parent relative attachment, optionally with a camera
+	static UParentRelativeAttachmentComponent * SpawnPawnStandIn(UWorld * World, bool bWithCamera)
+	{
+		AActor * Owner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+		USceneComponent * Root = NewObject<USceneComponent>(Owner, TEXT("Root"));
+		Owner->SetRootComponent(Root);
+		Root->RegisterComponent();
+
+		if (bWithCamera)
+			AddCamera(Owner);
+
+		UParentRelativeAttachmentComponent * Attachment = NewObject<UParentRelativeAttachmentComponent>(Owner);
+		Attachment->SetupAttachment(Root);
+		Attachment->RegisterComponent();
+		return Attachment;
+	}
+
+	static double TickAll(const TArray<UParentRelativeAttachmentComponent*> & Attachments, int NumFrames, bool bForceOwnerLookup)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (UParentRelativeAttachmentComponent * Attachment : Attachments)
+			{
+				// Same cost as the old per tick cast and component scan
+				if (bForceOwnerLookup)
+					Attachment->InvalidateOwnerCache();
+
+				Attachment->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+bool FParentRelativeAttachmentBenchmark::RunTest(const FString& Parameters)
+{
+	const int NumPawns = 200;
+	const int NumFrames = 300;
+
+	FVRExpansionTestWorld TestWorld(TEXT("ParentRelativeAttachmentBenchmarkWorld"));
+
+	TArray<UParentRelativeAttachmentComponent*> Attachments;
+	for (int i = 0; i < NumPawns; ++i)
+	{
+		Attachments.Add(ParentRelativeAttachmentTests::SpawnPawnStandIn(TestWorld.GetWorld(), true));
+	}
+
+	const double LookupSeconds = ParentRelativeAttachmentTests::TickAll(Attachments, NumFrames, true);
+	const double CachedSeconds = ParentRelativeAttachmentTests::TickAll(Attachments, NumFrames, false);
+
+	AddInfo(FString::Printf(TEXT("%d attachments x %d frames: cached %.3f ms/frame, owner lookup every tick %.3f ms/frame"),
+		NumPawns, NumFrames, CachedSeconds * 1000.0 / NumFrames, LookupSeconds * 1000.0 / NumFrames));
+
+	int NumWrong = 0;
+	for (UParentRelativeAttachmentComponent * Attachment : Attachments)
+	{
+		if (!Attachment->RelativeLocation.Equals(ParentRelativeAttachmentTests::CameraLocation, KINDA_SMALL_NUMBER))
+			NumWrong++;
+	}
+	TestEqual(TEXT("Attachments not following their camera"), NumWrong, 0);
+
+	return true;
+}
+
+bool FParentRelativeAttachmentRuntimeCameraTest::RunTest(const FString& Parameters)
+{
+	FVRExpansionTestWorld TestWorld(TEXT("ParentRelativeAttachmentCameraWorld"));
+
+	UParentRelativeAttachmentComponent * Attachment = ParentRelativeAttachmentTests::SpawnPawnStandIn(TestWorld.GetWorld(), false);
+	Attachment->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+	TestTrue(TEXT("No camera, attachment stays at the root"), Attachment->RelativeLocation.IsNearlyZero());
+
+	// No InvalidateOwnerCache call, the new component has to be picked up on its own
+	UCameraComponent * Camera = ParentRelativeAttachmentTests::AddCamera(Attachment->GetOwner());
+	Attachment->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+	TestTrue(TEXT("Attachment follows the camera added at runtime"), Attachment->RelativeLocation.Equals(ParentRelativeAttachmentTests::CameraLocation, KINDA_SMALL_NUMBER));
+
+	// Camera removed, the cached camera must not be used any more
+	Camera->DestroyComponent();
+	Attachment->SetRelativeLocation(FVector::ZeroVector);
+	Attachment->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+	TestTrue(TEXT("Attachment stops following a destroyed camera"), Attachment->RelativeLocation.IsNearlyZero());
+
+	return true;
+}
+
+#endif
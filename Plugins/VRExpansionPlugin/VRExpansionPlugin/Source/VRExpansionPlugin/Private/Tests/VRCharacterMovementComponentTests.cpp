@@ -0,0 +1,398 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "VRCharacter.h"
+#include "VRCharacterMovementComponent.h"
+#include "VRCharacterRepulsionManager.h"
+#include "VRExpansionTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRCharacterRepulsionProxyTest, "VRExpansion.Character.RepulsionProxiesOnlyPush", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSavedMovePoolTest, "VRExpansion.Character.SavedMovePoolUsesDerivedMoves", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSavedMoveNetLoopTest, "VRExpansion.Character.SavedMoveNetLoop150msLoss5", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSmoothingLODBenchmark, "VRExpansion.Character.SmoothingLOD64Proxies", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace VRCharacterMovementTests
+{
+	static AVRCharacter * SpawnCharacter(UWorld * World, const FVector & Location)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<AVRCharacter>(Location, FRotator::ZeroRotator, SpawnParams);
+	}
+
+	// Stands in for a project level move type
+	class FSavedMove_Test : public FSavedMove_VRCharacter
+	{
+	public:
+		static int32 NumAllocated;
+
+		FSavedMove_Test() : FSavedMove_VRCharacter()
+		{
+			NumAllocated++;
+		}
+	};
+	int32 FSavedMove_Test::NumAllocated = 0;
+
+	// Sends a correction to every proxy every few frames and smooths in between, like a 30hz server update at 90fps
+	static double SimulateProxies(const TArray<AVRCharacter*> & Proxies, int NumFrames, bool bUseSmoothingLOD)
+	{
+		const float DeltaTime = 1.0f / 90.0f;
+		const int CorrectionInterval = 3;
+
+		for (AVRCharacter * Proxy : Proxies)
+		{
+			UVRBaseCharacterMovementComponent * CharMove = Cast<UVRBaseCharacterMovementComponent>(Proxy->GetCharacterMovement());
+			CharMove->bUseNetworkSmoothingLOD = bUseSmoothingLOD;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (AVRCharacter * Proxy : Proxies)
+			{
+				UVRBaseCharacterMovementComponent * CharMove = Cast<UVRBaseCharacterMovementComponent>(Proxy->GetCharacterMovement());
+
+				if (Frame % CorrectionInterval == 0)
+				{
+					const FVector OldLocation = Proxy->GetActorLocation();
+					const FQuat OldRotation = Proxy->GetActorQuat();
+					const FVector NewLocation = OldLocation + FVector(0.0f, (Frame / CorrectionInterval) % 2 ? 8.0f : -8.0f, 0.0f);
+					CharMove->bNetworkSmoothingComplete = false;
+					CharMove->SmoothCorrection(OldLocation, OldRotation, NewLocation, OldRotation);
+				}
+
+				if (!CharMove->bNetworkSmoothingComplete)
+					CharMove->SmoothClientPosition(DeltaTime);
+			}
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	class FNetworkPredictionData_Client_Test : public FNetworkPredictionData_Client_VRCharacter
+	{
+	public:
+		FNetworkPredictionData_Client_Test(const UCharacterMovementComponent& ClientMovement)
+			: FNetworkPredictionData_Client_VRCharacter(ClientMovement)
+		{}
+
+		int32 NumAllocateCalls = 0;
+
+		virtual FSavedMovePtr AllocateNewMove() override
+		{
+			NumAllocateCalls++;
+			return FSavedMovePtr(new FSavedMove_Test());
+		}
+	};
+
+	struct FNetLoopResult
+	{
+		int32 NumAllocations;
+		int32 NumSteadyStateAllocations;
+		int32 NumServerMoveVR;
+		int32 NumServerMoveVRDual;
+		int32 NumCombined;
+		int32 PeakSavedMoves;
+	};
+
+	// Runs the client side of ReplicateMoveToServer (saved move creation, combining, delaying and sending) against a simulated link.
+	// The pawn stands still with a steady HMD, the tracking noise stays below the replicated precision.
+	// Acks arrive a round trip after the send unless the send was lost, and free every move up to the acked one like ClientAckGoodMove.
+	static FNetLoopResult SimulateNetLoop(AVRCharacter * Character, UVRCharacterMovementComponent * CharMove, bool bQuantizedMerging, int32 Seed)
+	{
+		const float DeltaTime = 1.0f / 90.0f;
+		const float NetMoveDelta = 1.0f / 60.0f;
+		const float Latency = 0.15f;
+		const float LossRate = 0.05f;
+		const int NumFrames = 900;
+		const int SteadyStateFrame = 90;
+
+		CharMove->bAllowMovementMerging = true;
+		CharMove->bAllowQuantizedMovementMerging = bQuantizedMerging;
+
+		FNetLoopResult Result;
+		FMemory::Memzero(Result);
+
+		FNetworkPredictionData_Client_Test ClientData(*CharMove);
+		FRandomStream Stream(Seed);
+		TArray<TPair<float, float>> InFlightAcks;
+		FSavedMovePtr PendingMove;
+		float Time = 0.0f;
+		float LastSendTime = -1.0f;
+		int32 AllocationsAtSteadyState = 0;
+
+		for (int Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Time += DeltaTime;
+			if (Frame == SteadyStateFrame)
+				AllocationsAtSteadyState = ClientData.NumAllocateCalls;
+
+			for (int i = InFlightAcks.Num() - 1; i >= 0; --i)
+			{
+				if (InFlightAcks[i].Key > Time)
+					continue;
+
+				const int32 MoveIndex = ClientData.GetSavedMoveIndex(InFlightAcks[i].Value);
+				if (MoveIndex != INDEX_NONE)
+					ClientData.AckMove(MoveIndex);
+				InFlightAcks.RemoveAt(i);
+			}
+
+			const float MoveDeltaTime = ClientData.UpdateTimeStampAndDeltaTime(DeltaTime, *Character, *CharMove);
+			FSavedMovePtr NewMove = ClientData.CreateSavedMove();
+			NewMove->SetMoveFor(Character, MoveDeltaTime, FVector::ZeroVector, ClientData);
+
+			FSavedMove_VRBaseCharacter * VRMove = (FSavedMove_VRBaseCharacter *)NewMove.Get();
+			VRMove->LFDiff = FVector(Stream.FRandRange(-0.002f, 0.002f), Stream.FRandRange(-0.002f, 0.002f), 90.0f + Stream.FRandRange(-0.002f, 0.002f));
+			VRMove->VRCapsuleRotation = FRotator(0.0f, 30.0f, 0.0f);
+
+			if (PendingMove.IsValid() && !PendingMove->bOldTimeStampBeforeReset)
+			{
+				const float MaxCombineDelta = ClientData.MaxMoveDeltaTime * Character->GetActorTimeDilation();
+				bool bCombineMoves = PendingMove->CanCombineWith(NewMove, Character, MaxCombineDelta);
+				if (!bCombineMoves && bQuantizedMerging)
+					bCombineMoves = ((FSavedMove_VRBaseCharacter *)PendingMove.Get())->CanCombineWithQuantized(NewMove, Character, MaxCombineDelta);
+
+				if (bCombineMoves)
+				{
+					NewMove->DeltaTime += PendingMove->DeltaTime;
+					if (ClientData.SavedMoves.Num() > 0 && ClientData.SavedMoves.Last() == PendingMove)
+						ClientData.SavedMoves.Pop();
+					ClientData.FreeMove(PendingMove);
+					PendingMove = nullptr;
+					Result.NumCombined++;
+				}
+			}
+
+			NewMove->PostUpdate(Character, FSavedMove_Character::PostUpdate_Record);
+			ClientData.SavedMoves.Push(NewMove);
+			Result.PeakSavedMoves = FMath::Max(Result.PeakSavedMoves, ClientData.SavedMoves.Num());
+
+			if (!PendingMove.IsValid() && Time - LastSendTime < NetMoveDelta)
+			{
+				PendingMove = NewMove;
+				continue;
+			}
+
+			// A move still pending here goes out with the new one in a dual RPC
+			if (PendingMove.IsValid())
+				Result.NumServerMoveVRDual++;
+			else
+				Result.NumServerMoveVR++;
+
+			LastSendTime = Time;
+			PendingMove = nullptr;
+
+			if (Stream.FRand() >= LossRate)
+				InFlightAcks.Add(TPair<float, float>(Time + Latency, NewMove->TimeStamp));
+		}
+
+		Result.NumAllocations = ClientData.NumAllocateCalls;
+		Result.NumSteadyStateAllocations = ClientData.NumAllocateCalls - AllocationsAtSteadyState;
+		return Result;
+	}
+}
+
+bool FVRCharacterRepulsionProxyTest::RunTest(const FString& Parameters)
+{
+	FVRExpansionTestWorld TestWorld(TEXT("VRCharacterRepulsionWorld"));
+	UWorld * World = TestWorld.GetWorld();
+
+	// Overlapping characters, the proxy is on the +X side of the local one
+	AVRCharacter * Local = VRCharacterMovementTests::SpawnCharacter(World, FVector(0.0f, 0.0f, 100.0f));
+	AVRCharacter * Proxy = VRCharacterMovementTests::SpawnCharacter(World, FVector(20.0f, 0.0f, 100.0f));
+	if (!TestNotNull(TEXT("Local character"), Local) || !TestNotNull(TEXT("Proxy character"), Proxy))
+		return false;
+
+	UVRCharacterMovementComponent * LocalMove = Cast<UVRCharacterMovementComponent>(Local->GetCharacterMovement());
+	UVRCharacterMovementComponent * ProxyMove = Cast<UVRCharacterMovementComponent>(Proxy->GetCharacterMovement());
+	if (!TestNotNull(TEXT("Local movement"), LocalMove) || !TestNotNull(TEXT("Proxy movement"), ProxyMove))
+		return false;
+
+	LocalMove->bUseCharacterRepulsionGrid = true;
+	LocalMove->CharacterRepulsionStrength = 200.0f;
+	ProxyMove->bUseCharacterRepulsionGrid = true;
+	ProxyMove->CharacterRepulsionStrength = 200.0f;
+	Proxy->Role = ROLE_SimulatedProxy;
+
+	FVRCharacterRepulsionManager & RepulsionManager = FVRCharacterRepulsionManager::Get(World);
+	RepulsionManager.Register(LocalMove);
+
+	// The proxy joins the grid from its tick, it never runs a move
+	ProxyMove->UpdateSimulatedProxyRepulsion();
+	TestTrue(TEXT("Proxy is in the repulsion grid"), ProxyMove->RepulsionGridIndex != INDEX_NONE);
+
+	const FVector PushFromProxy = RepulsionManager.GetRepulsionVelocity(LocalMove);
+	TestTrue(TEXT("Local character is pushed away from the proxy"), PushFromProxy.X < -KINDA_SMALL_NUMBER);
+
+	// Running the proxies repulsion must neither push it nor drop it from the grid
+	ProxyMove->ApplyRepulsionForce(1.0f / 90.0f);
+	TestTrue(TEXT("Proxy stays in the repulsion grid"), ProxyMove->RepulsionGridIndex != INDEX_NONE);
+
+	// With the grid off on the proxy the local character isn't pushed any more
+	ProxyMove->bUseCharacterRepulsionGrid = false;
+	ProxyMove->UpdateSimulatedProxyRepulsion();
+	TestTrue(TEXT("Proxy left the repulsion grid"), ProxyMove->RepulsionGridIndex == INDEX_NONE);
+	TestTrue(TEXT("No push without the proxy"), RepulsionManager.GetRepulsionVelocity(LocalMove).IsNearlyZero());
+
+	FVRCharacterRepulsionManager::Unregister(LocalMove);
+	return true;
+}
+
+bool FVRSavedMovePoolTest::RunTest(const FString& Parameters)
+{
+	using namespace VRCharacterMovementTests;
+
+	FVRExpansionTestWorld TestWorld(TEXT("VRSavedMovePoolWorld"));
+	AVRCharacter * Character = SpawnCharacter(TestWorld.GetWorld(), FVector(0.0f, 0.0f, 100.0f));
+	if (!TestNotNull(TEXT("Character"), Character))
+		return false;
+
+	UVRCharacterMovementComponent * CharMove = Cast<UVRCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!TestNotNull(TEXT("Movement"), CharMove))
+		return false;
+
+	CharMove->SavedMovePoolSize = 8;
+	FSavedMove_Test::NumAllocated = 0;
+
+	{
+		FNetworkPredictionData_Client_Test ClientData(*CharMove);
+
+		// Nothing may be allocated while the derived type is still being constructed
+		TestEqual(TEXT("No moves allocated by the constructor"), FSavedMove_Test::NumAllocated, 0);
+		TestEqual(TEXT("Free list starts empty"), ClientData.FreeMoves.Num(), 0);
+		TestEqual(TEXT("Max free moves follows the pool size"), ClientData.MaxFreeMoveCount, CharMove->SavedMovePoolSize);
+
+		FSavedMovePtr FirstMove = ClientData.CreateSavedMove();
+		TestTrue(TEXT("First move is valid"), FirstMove.IsValid());
+		TestEqual(TEXT("Pool filled through the derived AllocateNewMove"), ClientData.NumAllocateCalls, CharMove->SavedMovePoolSize);
+		TestEqual(TEXT("Every pooled move is the derived type"), FSavedMove_Test::NumAllocated, CharMove->SavedMovePoolSize);
+		TestEqual(TEXT("First move came out of the pool"), ClientData.FreeMoves.Num(), CharMove->SavedMovePoolSize - 1);
+
+		// Recycling doesn't allocate or refill
+		ClientData.FreeMove(FirstMove);
+		FirstMove = nullptr;
+		FSavedMovePtr SecondMove = ClientData.CreateSavedMove();
+		TestTrue(TEXT("Second move is valid"), SecondMove.IsValid());
+		TestEqual(TEXT("Recycled move didn't allocate"), ClientData.NumAllocateCalls, CharMove->SavedMovePoolSize);
+		TestEqual(TEXT("Free list after recycling"), ClientData.FreeMoves.Num(), CharMove->SavedMovePoolSize - 1);
+	}
+
+	return true;
+}
+
+bool FVRSavedMoveNetLoopTest::RunTest(const FString& Parameters)
+{
+	using namespace VRCharacterMovementTests;
+
+	FVRExpansionTestWorld TestWorld(TEXT("VRSavedMoveNetLoopWorld"));
+	AVRCharacter * Character = SpawnCharacter(TestWorld.GetWorld(), FVector(0.0f, 0.0f, 100.0f));
+	if (!TestNotNull(TEXT("Character"), Character))
+		return false;
+
+	UVRCharacterMovementComponent * CharMove = Cast<UVRCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!TestNotNull(TEXT("Movement"), CharMove))
+		return false;
+
+	const FNetLoopResult Exact = SimulateNetLoop(Character, CharMove, false, 4219);
+	const FNetLoopResult Quantized = SimulateNetLoop(Character, CharMove, true, 4219);
+
+	AddInfo(FString::Printf(TEXT("Exact merging: %d allocations (%d after warm up), %d ServerMoveVR, %d ServerMoveVRDual, %d combined, %d peak saved moves"),
+		Exact.NumAllocations, Exact.NumSteadyStateAllocations, Exact.NumServerMoveVR, Exact.NumServerMoveVRDual, Exact.NumCombined, Exact.PeakSavedMoves));
+	AddInfo(FString::Printf(TEXT("Quantized merging: %d allocations (%d after warm up), %d ServerMoveVR, %d ServerMoveVRDual, %d combined, %d peak saved moves"),
+		Quantized.NumAllocations, Quantized.NumSteadyStateAllocations, Quantized.NumServerMoveVR, Quantized.NumServerMoveVRDual, Quantized.NumCombined, Quantized.PeakSavedMoves));
+
+	// The pool covers a 150ms round trip with losses, nothing is allocated once it is filled
+	TestEqual(TEXT("Exact merging allocates only the pool"), Exact.NumAllocations, CharMove->SavedMovePoolSize);
+	TestEqual(TEXT("Quantized merging allocates only the pool"), Quantized.NumAllocations, CharMove->SavedMovePoolSize);
+	TestEqual(TEXT("No allocations after warm up with exact merging"), Exact.NumSteadyStateAllocations, 0);
+	TestEqual(TEXT("No allocations after warm up with quantized merging"), Quantized.NumSteadyStateAllocations, 0);
+
+	// HMD noise keeps the exact check from merging, the quantized check folds the delayed moves in instead of sending them as duals
+	TestEqual(TEXT("Exact merging never combines noisy HMD moves"), Exact.NumCombined, 0);
+	TestTrue(TEXT("Quantized merging combines moves"), Quantized.NumCombined > 0);
+	TestTrue(TEXT("Quantized merging sends fewer dual moves"), Quantized.NumServerMoveVRDual < Exact.NumServerMoveVRDual);
+	TestTrue(TEXT("Quantized merging keeps fewer saved moves"), Quantized.PeakSavedMoves < Exact.PeakSavedMoves);
+
+	return true;
+}
+
+bool FVRSmoothingLODBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace VRCharacterMovementTests;
+
+	const int NumProxies = 64;
+	const int NumFrames = 300;
+
+	FVRExpansionTestWorld TestWorld(TEXT("VRSmoothingLODBenchmarkWorld"));
+	UWorld * World = TestWorld.GetWorld();
+
+	// The local view, its camera sits at the origin
+	APlayerController * PC = World->SpawnActor<APlayerController>();
+	if (!TestNotNull(TEXT("Player controller"), PC) || !TestNotNull(TEXT("Camera manager"), PC->PlayerCameraManager))
+		return false;
+
+	// Quarter close, quarter mid range, quarter far and quarter close but occluded
+	TArray<AVRCharacter*> Proxies;
+	int NumExpected[3] = { 0, 0, 0 };
+	for (int i = 0; i < NumProxies; ++i)
+	{
+		const int Group = i % 4;
+		const float Distance = (Group == 1) ? 2500.0f : (Group == 2) ? 6000.0f : 500.0f;
+		const FVector Location = FRotator(0.0f, 360.0f * i / NumProxies, 0.0f).Vector() * Distance + FVector(0.0f, 0.0f, 100.0f);
+
+		AVRCharacter * Proxy = SpawnCharacter(World, Location);
+		if (!TestNotNull(TEXT("Proxy"), Proxy))
+			return false;
+
+		Proxy->Role = ROLE_SimulatedProxy;
+		UVRBaseCharacterMovementComponent * CharMove = Cast<UVRBaseCharacterMovementComponent>(Proxy->GetCharacterMovement());
+		CharMove->NetworkSmoothingMode = ENetworkSmoothingMode::Exponential;
+		CharMove->SmoothingLODReducedDistance = 1500.0f;
+		CharMove->SmoothingLODSnapDistance = 4000.0f;
+
+		// Nothing renders in the test world, so the render time check is forced either way
+		CharMove->SmoothingLODOcclusionTime = (Group == 3) ? -1.0f : BIG_NUMBER;
+
+		Proxies.Add(Proxy);
+		NumExpected[(Group == 0) ? (int)EVRSmoothingLOD::Full : (Group == 1) ? (int)EVRSmoothingLOD::Reduced : (int)EVRSmoothingLOD::Snap]++;
+	}
+
+	int NumTiers[3] = { 0, 0, 0 };
+	for (AVRCharacter * Proxy : Proxies)
+	{
+		NumTiers[(int)Cast<UVRBaseCharacterMovementComponent>(Proxy->GetCharacterMovement())->GetNetworkSmoothingLOD()]++;
+	}
+	TestEqual(TEXT("Full tier proxies"), NumTiers[(int)EVRSmoothingLOD::Full], NumExpected[(int)EVRSmoothingLOD::Full]);
+	TestEqual(TEXT("Reduced tier proxies"), NumTiers[(int)EVRSmoothingLOD::Reduced], NumExpected[(int)EVRSmoothingLOD::Reduced]);
+	TestEqual(TEXT("Snap tier proxies"), NumTiers[(int)EVRSmoothingLOD::Snap], NumExpected[(int)EVRSmoothingLOD::Snap]);
+
+	const double FullSeconds = SimulateProxies(Proxies, NumFrames, false);
+	const double LODSeconds = SimulateProxies(Proxies, NumFrames, true);
+
+	AddInfo(FString::Printf(TEXT("%d proxies x %d frames: smoothing LOD %.3f ms/frame, full smoothing %.3f ms/frame"),
+		NumProxies, NumFrames, LODSeconds * 1000.0 / NumFrames, FullSeconds * 1000.0 / NumFrames));
+
+	// Snapped proxies have to be sitting on their capsule with nothing left to smooth
+	int NumUnsnapped = 0;
+	for (AVRCharacter * Proxy : Proxies)
+	{
+		UVRBaseCharacterMovementComponent * CharMove = Cast<UVRBaseCharacterMovementComponent>(Proxy->GetCharacterMovement());
+		if (CharMove->GetNetworkSmoothingLOD() != EVRSmoothingLOD::Snap)
+			continue;
+
+		FNetworkPredictionData_Client_Character * ClientData = CharMove->GetPredictionData_Client_Character();
+		if (!CharMove->bNetworkSmoothingComplete || !ClientData || !ClientData->MeshTranslationOffset.IsNearlyZero())
+			NumUnsnapped++;
+	}
+	TestEqual(TEXT("Snap tier proxies left with a smoothing offset"), NumUnsnapped, 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "VRCharacterRepulsionManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRCharacterRepulsionGridTest, "VRExpansion.Character.RepulsionGridMatchesBruteForce", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace VRCharacterRepulsionTests
+{
+	// Same range as the manager uses
+	static const float RangeScale = 1.2f;
+
+	struct FCrowd
+	{
+		TArray<float> PosX;
+		TArray<float> PosY;
+		TArray<float> MinZ;
+		TArray<float> MaxZ;
+		TArray<float> Radius;
+		TArray<float> Strength;
+	};
+
+	// Seeded crowd packed tight enough that most capsules push a few neighbours, with mixed sizes, heights and strengths
+	static void MakeCrowd(int32 Seed, int NumMembers, FCrowd & Crowd)
+	{
+		FRandomStream Stream(Seed);
+		const float HalfExtent = FMath::Sqrt((float)NumMembers) * 40.0f;
+
+		for (int i = 0; i < NumMembers; i++)
+		{
+			const float HalfHeight = Stream.FRandRange(40.0f, 100.0f);
+			const float CenterZ = Stream.FRandRange(0.0f, 150.0f);
+			Crowd.PosX.Add(Stream.FRandRange(-HalfExtent, HalfExtent));
+			Crowd.PosY.Add(Stream.FRandRange(-HalfExtent, HalfExtent));
+			Crowd.MinZ.Add(CenterZ - HalfHeight);
+			Crowd.MaxZ.Add(CenterZ + HalfHeight);
+			Crowd.Radius.Add(Stream.FRandRange(15.0f, 45.0f));
+			Crowd.Strength.Add(Stream.FRandRange(50.0f, 200.0f));
+		}
+
+		// A pair exactly on top of each other
+		Crowd.PosX[1] = Crowd.PosX[0];
+		Crowd.PosY[1] = Crowd.PosY[0];
+	}
+
+	// O(n^2) reference, every pair tested once in index order
+	static void BruteForce(const FCrowd & Crowd, TArray<FVector> & OutResults)
+	{
+		const int NumMembers = Crowd.PosX.Num();
+		OutResults.Reset();
+		OutResults.AddZeroed(NumMembers);
+
+		for (int i = 0; i < NumMembers; i++)
+		{
+			for (int j = i + 1; j < NumMembers; j++)
+			{
+				if (Crowd.MinZ[i] >= Crowd.MaxZ[j] || Crowd.MinZ[j] >= Crowd.MaxZ[i])
+					continue;
+
+				const float DX = Crowd.PosX[j] - Crowd.PosX[i];
+				const float DY = Crowd.PosY[j] - Crowd.PosY[i];
+				const float Range = (Crowd.Radius[i] + Crowd.Radius[j]) * RangeScale;
+				const float Dist = FMath::Sqrt(DX * DX + DY * DY);
+
+				if (Dist >= Range)
+					continue;
+
+				// Stacked capsules fall back to X, the grid bins in index order so it visits them in the same order
+				const FVector Dir = Dist > KINDA_SMALL_NUMBER ? FVector(DX / Dist, DY / Dist, 0.0f) : FVector(1.0f, 0.0f, 0.0f);
+				const float Falloff = 1.0f - (Dist / Range);
+
+				OutResults[i] -= Dir * Falloff * Crowd.Strength[i];
+				OutResults[j] += Dir * Falloff * Crowd.Strength[j];
+			}
+		}
+	}
+}
+
+bool FVRCharacterRepulsionGridTest::RunTest(const FString& Parameters)
+{
+	const int32 Seeds[] = { 1, 1337, 90210 };
+	const int CrowdSizes[] = { 50, 100, 250, 500 };
+	const float Tolerance = 0.01f;
+
+	for (const int32 Seed : Seeds)
+	{
+		for (const int NumMembers : CrowdSizes)
+		{
+			VRCharacterRepulsionTests::FCrowd Crowd;
+			VRCharacterRepulsionTests::MakeCrowd(Seed, NumMembers, Crowd);
+
+			TArray<FVector> Expected;
+			VRCharacterRepulsionTests::BruteForce(Crowd, Expected);
+
+			FVRCharacterRepulsionManager Manager;
+			Manager.PosX = Crowd.PosX;
+			Manager.PosY = Crowd.PosY;
+			Manager.MinZ = Crowd.MinZ;
+			Manager.MaxZ = Crowd.MaxZ;
+			Manager.Radius = Crowd.Radius;
+			Manager.Strength = Crowd.Strength;
+			Manager.Results.AddZeroed(NumMembers);
+
+			float MaxRadius = 0.0f;
+			for (const float CapsuleRadius : Crowd.Radius)
+				MaxRadius = FMath::Max(MaxRadius, CapsuleRadius);
+
+			Manager.CalculatePushes(MaxRadius);
+
+			int NumPushed = 0;
+			for (int i = 0; i < NumMembers; i++)
+			{
+				const FVector & Result = Manager.Results[i];
+				if (!Result.Equals(Expected[i], Tolerance))
+				{
+					AddError(FString::Printf(TEXT("Seed %d, %d members: member %d grid %s, brute force %s"), Seed, NumMembers, i, *Result.ToString(), *Expected[i].ToString()));
+				}
+
+				if (!Expected[i].IsNearlyZero())
+					NumPushed++;
+			}
+
+			TestTrue(FString::Printf(TEXT("Seed %d, %d members: crowd is dense enough to push"), Seed, NumMembers), NumPushed > NumMembers / 4);
+		}
+	}
+
+	return true;
+}
+
+#endif
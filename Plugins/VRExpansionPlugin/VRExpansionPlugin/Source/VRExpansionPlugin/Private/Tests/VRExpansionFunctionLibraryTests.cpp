@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/ConvexHull2d.h"
+#include "Math/RandomStream.h"
+#include "HAL/PlatformTime.h"
+#include "VRExpansionFunctionLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRMinimumAreaRectangleBenchmark, "VRExpansion.FunctionLibrary.MinimumAreaRectangle10k", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+namespace VRMinimumAreaRectangleTests
+{
+	// Brute force reference, engine hull and a full scan of every hull edge, points are already in the XY plane
+	static float ReferenceMinimumArea(const TArray<FVector> & Points)
+	{
+		TArray<int32> HullIndices;
+		ConvexHull2D::ComputeConvexHull(Points, HullIndices);
+
+		float MinArea = -1.f;
+		for (int i = 0; i < HullIndices.Num(); ++i)
+		{
+			FVector U = Points[HullIndices[(i + 1) % HullIndices.Num()]] - Points[HullIndices[i]];
+			U.Z = 0.f;
+			U = U.GetSafeNormal();
+			const FVector V(-U.Y, U.X, 0.f);
+
+			float MinU = MAX_flt, MaxU = -MAX_flt, MinV = MAX_flt, MaxV = -MAX_flt;
+			for (int j = 0; j < HullIndices.Num(); ++j)
+			{
+				const FVector & Point = Points[HullIndices[j]];
+				MinU = FMath::Min(MinU, Point | U);
+				MaxU = FMath::Max(MaxU, Point | U);
+				MinV = FMath::Min(MinV, Point | V);
+				MaxV = FMath::Max(MaxV, Point | V);
+			}
+
+			const float Area = (MaxU - MinU) * (MaxV - MinV);
+			if (MinArea < 0.f || Area < MinArea)
+				MinArea = Area;
+		}
+		return MinArea;
+	}
+}
+
+bool FVRMinimumAreaRectangleBenchmark::RunTest(const FString& Parameters)
+{
+	const int NumPoints = 10000;
+	const int NumIterations = 20;
+	const float SizeX = 300.f;
+	const float SizeY = 120.f;
+
+	// Scan points spread over a rotated rectangle, so the expected answer is known
+	FRandomStream Stream(1337);
+	const FRotator RectRotation(0.f, 37.f, 0.f);
+	const FVector RectOrigin(50.f, -20.f, 0.f);
+	TArray<FVector> Points;
+	Points.Reserve(NumPoints);
+	for (int i = 0; i < NumPoints; ++i)
+	{
+		const FVector Local(Stream.FRandRange(-SizeX * 0.5f, SizeX * 0.5f), Stream.FRandRange(-SizeY * 0.5f, SizeY * 0.5f), 0.f);
+		Points.Add(RectOrigin + RectRotation.RotateVector(Local));
+	}
+
+	FVector RectCenter;
+	FRotator RectRot;
+	float SideX = 0.f, SideY = 0.f;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int i = 0; i < NumIterations; ++i)
+	{
+		UVRExpansionFunctionLibrary::NonAuthorityMinimumAreaRectangle(nullptr, Points, FVector::UpVector, RectCenter, RectRot, SideX, SideY, false);
+	}
+	const double AverageMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+	StartTime = FPlatformTime::Seconds();
+	float ReferenceArea = 0.f;
+	for (int i = 0; i < NumIterations; ++i)
+	{
+		ReferenceArea = VRMinimumAreaRectangleTests::ReferenceMinimumArea(Points);
+	}
+	const double ReferenceAverageMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+	AddInfo(FString::Printf(TEXT("MinimumAreaRectangle %d points: %.3f ms, brute force reference: %.3f ms"), NumPoints, AverageMs, ReferenceAverageMs));
+
+	// Same area as the brute force search, and close to the rectangle the points were spread over
+	const float Area = SideX * SideY;
+	TestEqual(TEXT("Area matches the brute force reference"), Area, ReferenceArea, ReferenceArea * 0.001f);
+	TestTrue(TEXT("Area is no larger than the source rectangle"), Area <= SizeX * SizeY * 1.001f);
+	TestEqual(TEXT("Long side"), FMath::Max(SideX, SideY), SizeX, SizeX * 0.01f);
+	TestEqual(TEXT("Short side"), FMath::Min(SideX, SideY), SizeY, SizeY * 0.01f);
+
+	// Every point has to be inside the rectangle
+	const FVector AxisX = RectRot.RotateVector(FVector::ForwardVector);
+	const FVector AxisY = RectRot.RotateVector(FVector::RightVector);
+	int NumOutside = 0;
+	for (int i = 0; i < NumPoints; ++i)
+	{
+		const FVector Offset = Points[i] - RectCenter;
+		if (FMath::Abs(Offset | AxisX) > SideX * 0.5f + 0.1f || FMath::Abs(Offset | AxisY) > SideY * 0.5f + 0.1f)
+			NumOutside++;
+	}
+	TestEqual(TEXT("Points outside of the rectangle"), NumOutside, 0);
+
+	return true;
+}
+
+#endif
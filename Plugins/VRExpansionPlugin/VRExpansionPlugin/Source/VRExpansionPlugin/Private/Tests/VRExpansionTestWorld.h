@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Game world for the plugins automation tests, destroyed when it goes out of scope
+class FVRExpansionTestWorld
+{
+public:
+
+	FVRExpansionTestWorld(const TCHAR * WorldName)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, FName(WorldName));
+		FWorldContext & WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+	}
+
+	~FVRExpansionTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UWorld * GetWorld() const { return World; }
+
+	// Spawns a block all box, used for floors and walls as the plugin has no test content
+	AActor * SpawnBox(const FVector & Center, const FVector & Extent)
+	{
+		AActor * BoxActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Center));
+		if (!BoxActor)
+			return nullptr;
+
+		UBoxComponent * Box = NewObject<UBoxComponent>(BoxActor, TEXT("Box"));
+		Box->SetBoxExtent(Extent, false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		BoxActor->SetRootComponent(Box);
+		Box->SetWorldLocation(Center);
+		Box->RegisterComponent();
+		return BoxActor;
+	}
+
+private:
+
+	UWorld * World;
+};
+
+#endif
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "VRBPDatatypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVREuroFilterSpeedCutoffTest, "VRExpansion.PoseFilter.EuroFilterCutoffRisesWithSpeed", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRPoseFilterRotationCutoffTest, "VRExpansion.PoseFilter.RotationCutoffRisesWithAngularSpeed", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace VRPoseFilterTests
+{
+	static const float TickRate = 90.f;
+	static const int NumTicks = 90;
+
+	// Runs a constant 100 cm/s move through the filter for a second, returns how far the output trails the raw value
+	static float RunLinearRamp(float CutoffSlope)
+	{
+		FBPEuroLowPassFilter EuroFilter(1.0f, CutoffSlope, 1.0f);
+		const float DeltaTime = 1.f / TickRate;
+		const FVector Velocity(100.f, 0.f, 0.f);
+
+		FVector Raw = FVector::ZeroVector;
+		FVector Filtered = FVector::ZeroVector;
+		for (int i = 0; i < NumTicks; ++i)
+		{
+			Raw = Velocity * (i * DeltaTime);
+			Filtered = EuroFilter.RunFilterSmoothing(Raw, DeltaTime);
+		}
+		return (Raw - Filtered).Size();
+	}
+
+	// Runs a constant 180 deg/s yaw through the pose filter for a second, returns how far (degrees) the output trails the raw rotation
+	static float RunYawRamp(float RotationCutoffSlope)
+	{
+		FBPVRPoseFilterSettings Settings;
+		Settings.RotationCutoffSlope = RotationCutoffSlope;
+		Settings.RotationDeadband = 0.f;
+
+		FVRPoseFilter PoseFilter;
+		const float DeltaTime = 1.f / TickRate;
+
+		FQuat Raw = FQuat::Identity;
+		FQuat Filtered = FQuat::Identity;
+		FVector FilteredPosition;
+		for (int i = 0; i < NumTicks; ++i)
+		{
+			Raw = FRotator(0.f, 180.f * i * DeltaTime, 0.f).Quaternion();
+			PoseFilter.Filter(Settings, FVector::ZeroVector, Raw, DeltaTime, FilteredPosition, Filtered);
+		}
+		return FMath::RadiansToDegrees(Filtered.AngularDistance(Raw));
+	}
+}
+
+bool FVREuroFilterSpeedCutoffTest::RunTest(const FString& Parameters)
+{
+	// The speed estimate is cm/s, so a slope has to shorten the lag of a steady move well below the fixed 1hz cutoff
+	const float FixedLag = VRPoseFilterTests::RunLinearRamp(0.f);
+	const float AdaptiveLag = VRPoseFilterTests::RunLinearRamp(0.05f);
+
+	AddInfo(FString::Printf(TEXT("Lag at 100 cm/s: fixed cutoff %.2f cm, adaptive cutoff %.2f cm"), FixedLag, AdaptiveLag));
+	TestTrue(TEXT("Fixed cutoff filter trails a steady move"), FixedLag > 5.f);
+	TestTrue(TEXT("Cutoff slope at least halves the lag of a steady move"), AdaptiveLag < FixedLag * 0.5f);
+
+	// A still value passes straight through
+	FBPEuroLowPassFilter EuroFilter;
+	const FVector Still(10.f, 20.f, 30.f);
+	FVector Filtered = FVector::ZeroVector;
+	for (int i = 0; i < 10; ++i)
+		Filtered = EuroFilter.RunFilterSmoothing(Still, 1.f / VRPoseFilterTests::TickRate);
+	TestTrue(TEXT("Still value is unchanged"), Filtered.Equals(Still, KINDA_SMALL_NUMBER));
+
+	return true;
+}
+
+bool FVRPoseFilterRotationCutoffTest::RunTest(const FString& Parameters)
+{
+	const float FixedLag = VRPoseFilterTests::RunYawRamp(0.f);
+	const float AdaptiveLag = VRPoseFilterTests::RunYawRamp(FBPVRPoseFilterSettings().RotationCutoffSlope);
+
+	AddInfo(FString::Printf(TEXT("Lag at 180 deg/s: fixed cutoff %.2f deg, adaptive cutoff %.2f deg"), FixedLag, AdaptiveLag));
+	TestTrue(TEXT("Fixed cutoff filter trails a steady turn"), FixedLag > 10.f);
+	TestTrue(TEXT("Rotation cutoff slope at least halves the lag of a steady turn"), AdaptiveLag < FixedLag * 0.5f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "VRSimpleCharacter.h"
+#include "VRSimpleCharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "VRExpansionTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSimpleFloorCacheEquivalenceTest, "VRExpansion.SimpleCharacter.FloorCacheMatchesFullFloorCheck", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVRSimpleFloorCacheWalkTest, "VRExpansion.SimpleCharacter.FloorCacheWalkMatchesUncachedWalk", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+namespace VRSimpleFloorCacheTests
+{
+	// Runs FindFloor with the cache off, then with it on (after seeding it at SeedLocation), and compares the results
+	static void CompareFloor(FAutomationTestBase & Test, const TCHAR * Case, UVRSimpleCharacterMovementComponent * MoveComp, const FVector & SeedLocation, const FVector & TestLocation)
+	{
+		FFindFloorResult Uncached;
+		MoveComp->bUseFloorResultCache = false;
+		MoveComp->FloorResultCache.Invalidate();
+		MoveComp->FindFloor(TestLocation, Uncached, false);
+
+		FFindFloorResult Seed, Cached;
+		MoveComp->bUseFloorResultCache = true;
+		MoveComp->FloorResultCache.Invalidate();
+		MoveComp->FindFloor(SeedLocation, Seed, false);
+		MoveComp->FindFloor(TestLocation, Cached, false);
+
+		Test.TestEqual(FString::Printf(TEXT("%s: blocking hit"), Case), Cached.bBlockingHit, Uncached.bBlockingHit);
+		Test.TestEqual(FString::Printf(TEXT("%s: walkable floor"), Case), Cached.bWalkableFloor, Uncached.bWalkableFloor);
+		Test.TestEqual(FString::Printf(TEXT("%s: floor distance"), Case), Cached.FloorDist, Uncached.FloorDist, 0.01f);
+		Test.TestTrue(FString::Printf(TEXT("%s: floor component"), Case), Cached.HitResult.Component == Uncached.HitResult.Component);
+	}
+
+	// Walks the character from Start at a constant velocity with PhysWalking, all steps run in the same frame like sub steps do
+	static void Walk(ACharacter * Character, UVRSimpleCharacterMovementComponent * MoveComp, const FVector & Start, const FVector & WalkVelocity, int NumSteps, float StepTime, TArray<FVector> & OutLocations)
+	{
+		const bool bUseCache = MoveComp->bUseFloorResultCache;
+		MoveComp->bUseFloorResultCache = false;
+		Character->SetActorLocation(Start, false, nullptr, ETeleportType::TeleportPhysics);
+		MoveComp->FindFloor(Character->GetActorLocation(), MoveComp->CurrentFloor, false);
+		MoveComp->bUseFloorResultCache = bUseCache;
+
+		MoveComp->Velocity = WalkVelocity;
+		MoveComp->Acceleration = FVector::ZeroVector;
+
+		OutLocations.Reset();
+		for (int i = 0; i < NumSteps; ++i)
+		{
+			MoveComp->PhysWalking(StepTime, 0);
+			OutLocations.Add(Character->GetActorLocation());
+		}
+	}
+}
+
+bool FVRSimpleFloorCacheEquivalenceTest::RunTest(const FString& Parameters)
+{
+	FVRExpansionTestWorld TestWorld(TEXT("VRSimpleFloorCacheWorld"));
+	UWorld * World = TestWorld.GetWorld();
+
+	// 4m floor with its top at z = 0
+	const float FloorHalfSize = 200.0f;
+	AActor * Floor = TestWorld.SpawnBox(FVector(0.0f, 0.0f, -10.0f), FVector(FloorHalfSize, FloorHalfSize, 10.0f));
+	AVRSimpleCharacter * Character = World->SpawnActor<AVRSimpleCharacter>(FVector(0.0f, 0.0f, 200.0f), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Floor"), Floor) || !TestNotNull(TEXT("Character"), Character))
+		return false;
+
+	UVRSimpleCharacterMovementComponent * MoveComp = Cast<UVRSimpleCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!TestNotNull(TEXT("VRSimpleCharacterMovementComponent"), MoveComp))
+		return false;
+
+	float CapsuleRadius, CapsuleHalfHeight;
+	Character->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+	const float StandingZ = CapsuleHalfHeight + 1.0f;
+	MoveComp->FloorCacheTolerance = 1.0f;
+
+	// Small move in the middle of the floor, the cache is used and has to match
+	VRSimpleFloorCacheTests::CompareFloor(*this, TEXT("Flat"), MoveComp, FVector(0.0f, 0.0f, StandingZ), FVector(0.5f, 0.0f, StandingZ));
+
+	// Small move that steps the capsule center over the edge of the floor
+	VRSimpleFloorCacheTests::CompareFloor(*this, TEXT("Ledge"), MoveComp, FVector(FloorHalfSize - 0.5f, 0.0f, StandingZ), FVector(FloorHalfSize + 0.3f, 0.0f, StandingZ));
+
+	// Small move where the capsule footprint starts hanging over the edge
+	VRSimpleFloorCacheTests::CompareFloor(*this, TEXT("Footprint over ledge"), MoveComp, FVector(FloorHalfSize - CapsuleRadius - 0.2f, 0.0f, StandingZ), FVector(FloorHalfSize - CapsuleRadius + 0.5f, 0.0f, StandingZ));
+
+	// A blocking hit has to drop the cache
+	MoveComp->bUseFloorResultCache = true;
+	MoveComp->FloorResultCache.Invalidate();
+	Character->SetActorLocation(FVector(0.0f, 0.0f, StandingZ));
+	FFindFloorResult Seed;
+	MoveComp->FindFloor(Character->GetActorLocation(), Seed, false);
+	TestTrue(TEXT("Cache seeded on a flat floor"), MoveComp->FloorResultCache.bIsValid);
+
+	TestWorld.SpawnBox(FVector(CapsuleRadius + 15.0f, 0.0f, 100.0f), FVector(10.0f, 100.0f, 100.0f));
+	FHitResult WallHit;
+	MoveComp->SafeMoveUpdatedComponent(FVector(50.0f, 0.0f, 0.0f), Character->GetActorQuat(), true, WallHit);
+	TestTrue(TEXT("Move into the wall was blocked"), WallHit.bBlockingHit);
+	TestFalse(TEXT("Cache dropped after a blocking hit"), MoveComp->FloorResultCache.bIsValid);
+
+	return true;
+}
+
+bool FVRSimpleFloorCacheWalkTest::RunTest(const FString& Parameters)
+{
+	FVRExpansionTestWorld TestWorld(TEXT("VRSimpleFloorCacheWalkWorld"));
+	UWorld * World = TestWorld.GetWorld();
+
+	// 4m floor with its top at z = 0, and a 5cm platform that the walk steps up onto
+	AActor * Floor = TestWorld.SpawnBox(FVector(0.0f, 0.0f, -10.0f), FVector(200.0f, 200.0f, 10.0f));
+	AActor * Platform = TestWorld.SpawnBox(FVector(120.0f, 0.0f, 2.5f), FVector(100.0f, 100.0f, 2.5f));
+	AVRSimpleCharacter * Character = World->SpawnActor<AVRSimpleCharacter>(FVector(0.0f, 0.0f, 200.0f), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Floor"), Floor) || !TestNotNull(TEXT("Platform"), Platform) || !TestNotNull(TEXT("Character"), Character))
+		return false;
+
+	UVRSimpleCharacterMovementComponent * MoveComp = Cast<UVRSimpleCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!TestNotNull(TEXT("VRSimpleCharacterMovementComponent"), MoveComp))
+		return false;
+
+	float CapsuleRadius, CapsuleHalfHeight;
+	Character->GetCapsuleComponent()->GetScaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	// No controller, and no friction or braking so the velocity holds for the whole walk
+	MoveComp->bRunPhysicsWithNoController = true;
+	MoveComp->GroundFriction = 0.0f;
+	MoveComp->BrakingDecelerationWalking = 0.0f;
+	MoveComp->FloorCacheTolerance = 1.0f;
+	MoveComp->SetMovementMode(MOVE_Walking);
+
+	// 0.5cm per step, slow enough for consecutive floor checks to land inside of the cache tolerance
+	const FVector Start(-60.0f, 0.0f, CapsuleHalfHeight + 1.0f);
+	const FVector WalkVelocity(30.0f, 0.0f, 0.0f);
+	const int NumSteps = 240;
+	const float StepTime = 1.0f / 60.0f;
+
+	TArray<FVector> UncachedLocations, CachedLocations;
+
+	MoveComp->bUseFloorResultCache = false;
+	MoveComp->FloorResultCache.Invalidate();
+	MoveComp->FloorResultCache.NumHits = MoveComp->FloorResultCache.NumMisses = 0;
+	VRSimpleFloorCacheTests::Walk(Character, MoveComp, Start, WalkVelocity, NumSteps, StepTime, UncachedLocations);
+	TestEqual(TEXT("Uncached walk never uses the cache"), MoveComp->FloorResultCache.NumHits + MoveComp->FloorResultCache.NumMisses, 0u);
+
+	MoveComp->bUseFloorResultCache = true;
+	MoveComp->FloorResultCache.Invalidate();
+	MoveComp->FloorResultCache.NumHits = MoveComp->FloorResultCache.NumMisses = 0;
+	VRSimpleFloorCacheTests::Walk(Character, MoveComp, Start, WalkVelocity, NumSteps, StepTime, CachedLocations);
+
+	const uint32 NumHits = MoveComp->FloorResultCache.NumHits;
+	const uint32 NumMisses = MoveComp->FloorResultCache.NumMisses;
+	AddInfo(FString::Printf(TEXT("Floor cache over %d steps: %u hits, %u misses"), NumSteps, NumHits, NumMisses));
+
+	if (!TestEqual(TEXT("Both walks ran every step"), CachedLocations.Num(), UncachedLocations.Num()))
+		return false;
+
+	for (int i = 0; i < NumSteps; ++i)
+	{
+		if (!CachedLocations[i].Equals(UncachedLocations[i], 0.01f))
+		{
+			AddError(FString::Printf(TEXT("Step %d: cached walk at %s, uncached walk at %s"), i, *CachedLocations[i].ToString(), *UncachedLocations[i].ToString()));
+			break;
+		}
+	}
+
+	TestTrue(TEXT("Walk moved forward"), UncachedLocations.Last().X > Start.X + 60.0f);
+	TestTrue(TEXT("Walk stepped up onto the platform"), UncachedLocations.Last().Z > Start.Z + 2.5f);
+	TestTrue(TEXT("Final position matches the uncached walk"), CachedLocations.Last().Equals(UncachedLocations.Last(), 0.01f));
+
+	// Flat steps reuse the floor, the step onto the platform and leaving the first floors bounds have to re-run the check
+	TestTrue(TEXT("Cache served most of the flat steps"), NumHits > NumMisses);
+	TestTrue(TEXT("Cache missed at least once for the platform"), NumMisses > 1);
+
+	return true;
+}
+
+#endif
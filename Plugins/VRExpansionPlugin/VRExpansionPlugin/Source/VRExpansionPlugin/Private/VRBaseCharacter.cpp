@@ -2,6 +2,7 @@
 
 #include "VRBaseCharacter.h"
 #include "VRPathFollowingComponent.h"
+#include "VRPoseFilterStage.h"
 //#include "Runtime/Engine/Private/EnginePrivate.h"
 
 DEFINE_LOG_CATEGORY(LogBaseVRCharacter);
@@ -209,6 +210,16 @@ FVector AVRBaseCharacter::GetTeleportLocation(FVector OriginalLocation)
 }
 
 
+bool AVRBaseCharacter::TeleportTo(const FVector& DestLocation, const FRotator& DestRotation, bool bIsATest, bool bNoCheck)
+{
+	bool bTeleportSucceeded = Super::TeleportTo(DestLocation, DestRotation, bIsATest, bNoCheck);
+
+	if (bTeleportSucceeded && !bIsATest && IsLocallyControlled())
+		FVRPoseFilterStage::ResetFilters();
+
+	return bTeleportSucceeded;
+}
+
 void AVRBaseCharacter::NotifyOfTeleport_Implementation()
 {
 	if (!IsLocallyControlled())
@@ -219,6 +230,11 @@ void AVRBaseCharacter::NotifyOfTeleport_Implementation()
 		if (RightMotionController)
 			RightMotionController->bIsPostTeleport = true;
 	}
+	else
+	{
+		// Server initiated teleports don't run TeleportTo on the owning client
+		FVRPoseFilterStage::ResetFilters();
+	}
 }
 
 void AVRBaseCharacter::ExtendedSimpleMoveToLocation(const FVector& GoalLocation, float AcceptanceRadius, bool bStopOnOverlap, bool bUsePathfinding, bool bProjectDestinationToNavigation, bool bCanStrafe, TSubclassOf<UNavigationQueryFilter> FilterClass, bool bAllowPartialPaths)
@@ -11,7 +11,12 @@
 #include "VRRootComponent.h"
 #include "VRPlayerController.h"
 #include "GameFramework/PhysicsVolume.h"
+#include "Camera/PlayerCameraManager.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char SmoothingLOD Full"), STAT_CharSmoothingLODFull, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char SmoothingLOD Reduced"), STAT_CharSmoothingLODReduced, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char SmoothingLOD Snap"), STAT_CharSmoothingLODSnap, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char SmoothingLOD Snapped Corrections"), STAT_CharSmoothingLODSnappedCorrections, STATGROUP_Character);
 
 UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -52,6 +57,13 @@ UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObje
 	NetworkSmoothingMode = ENetworkSmoothingMode::Disabled;
 	NetworkSimulatedSmoothRotationTime = 0.0f; // Don't smooth rotation, its not good
 
+	bUseNetworkSmoothingLOD = false;
+	SmoothingLODReducedDistance = 1500.0f;
+	SmoothingLODSnapDistance = 4000.0f;
+	SmoothingLODReducedRate = 20.0f;
+	SmoothingLODOcclusionTime = 0.5f;
+	SmoothingLODAccumulatedTime = 0.0f;
+
 	bWasInPushBack = false;
 	bIsInPushBack = false;
 
@@ -1139,11 +1151,100 @@ void UVRBaseCharacterMovementComponent::SmoothClientPosition(float DeltaSeconds)
 	// would need to be moved to the new smoothing component...... I am on the fence about whether supporting epics smoothing is worth it
 	// or if I should drop it and maybe run my own?
 
+	if (bUseNetworkSmoothingLOD)
+	{
+		switch (GetNetworkSmoothingLOD())
+		{
+		case EVRSmoothingLOD::Reduced:
+		{
+			INC_DWORD_STAT(STAT_CharSmoothingLODReduced);
+
+			// Step the interpolation over the accumulated time, a single large step is close to linear
+			SmoothingLODAccumulatedTime += DeltaSeconds;
+			if (SmoothingLODAccumulatedTime < 1.0f / SmoothingLODReducedRate)
+				return;
+
+			DeltaSeconds = SmoothingLODAccumulatedTime;
+			SmoothingLODAccumulatedTime = 0.0f;
+		}break;
+		case EVRSmoothingLOD::Snap:
+		{
+			INC_DWORD_STAT(STAT_CharSmoothingLODSnap);
+
+			// Step far enough to finish the correction, this completes smoothing so we won't run again until the next one
+			if (FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character())
+			{
+				DeltaSeconds = FMath::Max3(NetworkSimulatedSmoothLocationTime, NetworkSimulatedSmoothRotationTime, (float)(ClientData->SmoothingServerTimeStamp - ClientData->SmoothingClientTimeStamp)) + KINDA_SMALL_NUMBER;
+			}
+			SmoothingLODAccumulatedTime = 0.0f;
+		}break;
+		case EVRSmoothingLOD::Full:
+		default:
+		{
+			INC_DWORD_STAT(STAT_CharSmoothingLODFull);
+			SmoothingLODAccumulatedTime = 0.0f;
+		}break;
+		}
+	}
+
 	SmoothClientPosition_Interpolate(DeltaSeconds);
 	//SmoothClientPosition_UpdateVisuals(); No mesh, don't bother to run this
 	SmoothClientPosition_UpdateVRVisuals();
 }
 
+void UVRBaseCharacterMovementComponent::SmoothCorrection(const FVector& OldLocation, const FQuat& OldRotation, const FVector& NewLocation, const FQuat& NewRotation)
+{
+	if (!bUseNetworkSmoothingLOD || NetworkSmoothingMode == ENetworkSmoothingMode::Disabled || !HasValidData() || GetNetworkSmoothingLOD() != EVRSmoothingLOD::Snap)
+	{
+		Super::SmoothCorrection(OldLocation, OldRotation, NewLocation, NewRotation);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_CharSmoothingLODSnappedCorrections);
+
+	// Far or occluded, let the engine teleport the capsule as if smoothing was disabled and skip the offset setup
+	const ENetworkSmoothingMode SmoothingMode = NetworkSmoothingMode;
+	NetworkSmoothingMode = ENetworkSmoothingMode::Disabled;
+	Super::SmoothCorrection(OldLocation, OldRotation, NewLocation, NewRotation);
+	NetworkSmoothingMode = SmoothingMode;
+
+	// Drop any offset left over from an earlier correction so the smoother sits on the capsule
+	if (FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character())
+	{
+		ClientData->OriginalMeshTranslationOffset = FVector::ZeroVector;
+		ClientData->MeshTranslationOffset = FVector::ZeroVector;
+		ClientData->MeshRotationOffset = (NetworkSmoothingMode == ENetworkSmoothingMode::Linear) ? NewRotation : FQuat::Identity;
+		ClientData->MeshRotationTarget = ClientData->MeshRotationOffset;
+		SmoothClientPosition_UpdateVRVisuals();
+	}
+
+	SmoothingLODAccumulatedTime = 0.0f;
+}
+
+EVRSmoothingLOD UVRBaseCharacterMovementComponent::GetNetworkSmoothingLOD() const
+{
+	UWorld * World = GetWorld();
+	if (!World || !CharacterOwner)
+		return EVRSmoothingLOD::Full;
+
+	// Not rendered recently, nobody will see the pop
+	if (World->GetTimeSeconds() - CharacterOwner->GetLastRenderTime() > SmoothingLODOcclusionTime)
+		return EVRSmoothingLOD::Snap;
+
+	APlayerController * PC = World->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager)
+		return EVRSmoothingLOD::Full;
+
+	const float DistSq = FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), UpdatedComponent->GetComponentLocation());
+
+	if (DistSq > FMath::Square(SmoothingLODSnapDistance))
+		return EVRSmoothingLOD::Snap;
+	else if (DistSq > FMath::Square(SmoothingLODReducedDistance))
+		return EVRSmoothingLOD::Reduced;
+
+	return EVRSmoothingLOD::Full;
+}
+
 void UVRBaseCharacterMovementComponent::SmoothClientPosition_UpdateVRVisuals()
 {
 	//SCOPE_CYCLE_COUNTER(STAT_CharacterMovementSmoothClientPosition_Visual);
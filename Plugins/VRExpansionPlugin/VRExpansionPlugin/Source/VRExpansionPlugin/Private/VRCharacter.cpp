@@ -2,6 +2,7 @@
 
 #include "VRCharacter.h"
 #include "VRPathFollowingComponent.h"
+#include "VRPoseFilterStage.h"
 //#include "Runtime/Engine/Private/EnginePrivate.h"
 
 DEFINE_LOG_CATEGORY(LogVRCharacter);
@@ -66,6 +67,11 @@ void AVRCharacter::NotifyOfTeleport_Implementation()
 		if (RightMotionController)
 			RightMotionController->bIsPostTeleport = true;
 	}
+	else
+	{
+		// Server initiated teleports don't run TeleportTo on the owning client
+		FVRPoseFilterStage::ResetFilters();
+	}
 }
 
 FVector AVRCharacter::GetNavAgentLocation() const
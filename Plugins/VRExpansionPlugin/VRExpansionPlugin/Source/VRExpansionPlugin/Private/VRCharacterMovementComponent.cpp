@@ -16,6 +16,7 @@
 //#include "PhysicsEngine/DestructibleActor.h"
 #include "VRCharacter.h"
 #include "VRExpansionFunctionLibrary.h"
+#include "VRCharacterRepulsionManager.h"
 
 // @todo this is here only due to circular dependency to AIModule. To be removed
 #include "Navigation/PathFollowingComponent.h"
@@ -46,6 +47,10 @@ DECLARE_CYCLE_STAT(TEXT("Char NavProjectPoint"), STAT_CharNavProjectPoint, STATG
 DECLARE_CYCLE_STAT(TEXT("Char NavProjectLocation"), STAT_CharNavProjectLocation, STATGROUP_Character);
 DECLARE_CYCLE_STAT(TEXT("Char AdjustFloorHeight"), STAT_CharAdjustFloorHeight, STATGROUP_Character);
 DECLARE_CYCLE_STAT(TEXT("Char ProcessLanded"), STAT_CharProcessLanded, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char ServerMovesReceivedVR"), STAT_CharServerMovesReceivedVR, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char ServerMovesSimulatedVR"), STAT_CharServerMovesSimulatedVR, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char SavedMovesAllocatedVR"), STAT_CharSavedMovesAllocatedVR, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char QuantizedMovesCombinedVR"), STAT_CharQuantizedMovesCombinedVR, STATGROUP_Character);
 
 // MAGIC NUMBERS
 const float MAX_STEP_SIDE_Z = 0.08f;	// maximum z value for the normal on the vertical side of steps
@@ -449,6 +454,38 @@ FNetworkPredictionData_Server* UVRCharacterMovementComponent::GetPredictionData_
 	return ServerPredictionData;
 }
 
+FNetworkPredictionData_Client_VRCharacter::FNetworkPredictionData_Client_VRCharacter(const UCharacterMovementComponent& ClientMovement)
+	: FNetworkPredictionData_Client_Character(ClientMovement)
+	, bFilledFreeMoves(false)
+{
+	// CreateSavedMove pulls from the free list and FreeMove returns to it up to MaxFreeMoveCount
+	if (const UVRCharacterMovementComponent * VRMove = Cast<const UVRCharacterMovementComponent>(&ClientMovement))
+		MaxFreeMoveCount = FMath::Max(VRMove->SavedMovePoolSize, 0);
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_VRCharacter::CreateSavedMove()
+{
+	// Fill the pool here instead of the constructor so derived classes get their own move type from AllocateNewMove
+	if (!bFilledFreeMoves)
+	{
+		bFilledFreeMoves = true;
+		FreeMoves.Reserve(MaxFreeMoveCount);
+
+		for (int i = FreeMoves.Num(); i < MaxFreeMoveCount; i++)
+		{
+			FreeMoves.Push(AllocateNewMove());
+		}
+	}
+
+	return FNetworkPredictionData_Client_Character::CreateSavedMove();
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_VRCharacter::AllocateNewMove()
+{
+	INC_DWORD_STAT(STAT_CharSavedMovesAllocatedVR);
+	return FSavedMovePtr(new FSavedMove_VRCharacter());
+}
+
 void FSavedMove_VRCharacter::SetInitialPosition(ACharacter* C)
 {
 
@@ -590,6 +627,14 @@ void UVRCharacterMovementComponent::ServerMoveVRDual_Implementation(
 	MoveRepsOld.ClientMovementBase = MoveReps.ClientMovementBase;
 	MoveRepsOld.UnpackAndSetINTRotations(View0);
 
+	// Fold the pending move into the new one, the new move covers both of their delta times
+	if (CanCoalesceServerMoves(TimeStamp0, InAccel0, PendingFlags, OldConditionalReps, TimeStamp, InAccel, NewFlags, MoveReps, ClientMovementMode))
+	{
+		INC_DWORD_STAT(STAT_CharServerMovesReceivedVR);
+		ServerMoveVR_Implementation(TimeStamp, InAccel, ClientLoc, CapsuleLoc, ConditionalReps, FVector(OldLFDiff.X + LFDiff.X, OldLFDiff.Y + LFDiff.Y, LFDiff.Z), CapsuleYaw, NewFlags, MoveReps, ClientMovementMode);
+		return;
+	}
+
 	// Scope these, they nest with Outer references so it should work fine, this keeps the update rotation and move autonomous from double updating the char
 	FVRCharacterScopedMovementUpdate ScopedMovementUpdate(UpdatedComponent, bEnableScopedMovementUpdates ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
 	ServerMoveVR_Implementation(TimeStamp0, InAccel0, FVector(1.f, 2.f, 3.f), OldCapsuleLoc, OldConditionalReps, OldLFDiff, OldCapsuleYaw, PendingFlags, MoveRepsOld, ClientMovementMode);
@@ -621,6 +666,14 @@ void UVRCharacterMovementComponent::ServerMoveVRDualExLight_Implementation(
 	MoveRepsOld.ClientMovementBase = MoveReps.ClientMovementBase;
 	MoveRepsOld.UnpackAndSetINTRotations(View0);
 
+	// Fold the pending move into the new one, the new move covers both of their delta times
+	if (CanCoalesceServerMoves(TimeStamp0, FVector::ZeroVector, PendingFlags, OldConditionalReps, TimeStamp, FVector::ZeroVector, NewFlags, MoveReps, ClientMovementMode))
+	{
+		INC_DWORD_STAT(STAT_CharServerMovesReceivedVR);
+		ServerMoveVR_Implementation(TimeStamp, FVector::ZeroVector, ClientLoc, CapsuleLoc, ConditionalReps, FVector(OldLFDiff.X + LFDiff.X, OldLFDiff.Y + LFDiff.Y, LFDiff.Z), CapsuleYaw, NewFlags, MoveReps, ClientMovementMode);
+		return;
+	}
+
 	// Scope these, they nest with Outer references so it should work fine, this keeps the update rotation and move autonomous from double updating the char
 	FVRCharacterScopedMovementUpdate ScopedMovementUpdate(UpdatedComponent, bEnableScopedMovementUpdates ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
 	ServerMoveVR_Implementation(TimeStamp0, FVector::ZeroVector, FVector(1.f, 2.f, 3.f), OldCapsuleLoc, OldConditionalReps, OldLFDiff, OldCapsuleYaw, PendingFlags,  MoveRepsOld, ClientMovementMode);
@@ -641,6 +694,39 @@ void UVRCharacterMovementComponent::ServerMoveVRExLight_Implementation(
 	ServerMoveVR_Implementation(TimeStamp, FVector::ZeroVector, ClientLoc, CapsuleLoc, ConditionalReps, LFDiff, CapsuleYaw, MoveFlags, MoveReps, ClientMovementMode);
 }
 
+bool UVRCharacterMovementComponent::CanCoalesceServerMoves(float TimeStamp0, const FVector & InAccel0, uint8 PendingFlags, const FVRConditionalMoveRep & OldConditionalReps, float TimeStamp, const FVector & InAccel, uint8 NewFlags, const FVRConditionalMoveRep2 & MoveReps, uint8 ClientMovementMode)
+{
+	if (!bEnableServerMoveCoalescing || !HasValidData() || PendingFlags != NewFlags || !InAccel0.Equals(InAccel, 0.1f))
+		return false;
+
+	// The older move has to be fully described by the newer one, its one off inputs would be lost otherwise
+	if (!OldConditionalReps.CustomVRInputVector.IsZero() || !OldConditionalReps.RequestedVelocity.IsZero() || OldConditionalReps.MoveActionArray.MoveActions.Num() > 0)
+		return false;
+
+	// The dual RPC only carries the newer moves base and mode, so the server has to already be on that base and in that mode
+	// otherwise the older move is where the base / mode change happened and it has to be simulated on its own
+	if (MoveReps.ClientMovementBase != CharacterOwner->GetMovementBase())
+		return false;
+
+	TEnumAsByte<EMovementMode> NetMovementMode(MOVE_None);
+	TEnumAsByte<EMovementMode> NetGroundMode(MOVE_None);
+	uint8 NetCustomMode(0);
+	UnpackNetworkMovementMode(ClientMovementMode, NetMovementMode, NetCustomMode, NetGroundMode);
+	if (NetMovementMode != MovementMode || (NetMovementMode == MOVE_Custom && NetCustomMode != CustomMovementMode))
+		return false;
+
+	FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+	if (!ServerData)
+		return false;
+
+	// Pending move was already processed (or is older than the last one), nothing to fold in
+	if (TimeStamp0 <= ServerData->CurrentClientTimeStamp || TimeStamp <= TimeStamp0)
+		return false;
+
+	// Combined step can't be longer than a single move is allowed to be
+	return (TimeStamp - ServerData->CurrentClientTimeStamp) <= ServerData->MaxMoveDeltaTime;
+}
+
 void UVRCharacterMovementComponent::ServerMoveVR_Implementation(
 	float TimeStamp,
 	FVector_NetQuantize10 InAccel,
@@ -658,6 +744,8 @@ void UVRCharacterMovementComponent::ServerMoveVR_Implementation(
 		return;
 	}
 
+	INC_DWORD_STAT(STAT_CharServerMovesReceivedVR);
+
 	FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
 	check(ServerData);
 
@@ -760,6 +848,7 @@ void UVRCharacterMovementComponent::ServerMoveVR_Implementation(
 			*/
 		}
 
+		INC_DWORD_STAT(STAT_CharServerMovesSimulatedVR);
 		MoveAutonomous(TimeStamp, DeltaTime, MoveFlags, Accel);
 		bHasRequestedVelocity = false;
 	}
@@ -1374,7 +1463,24 @@ void UVRCharacterMovementComponent::ReplicateMoveToServer(float DeltaTime, const
 	// do not combine moves which have different TimeStamps (before and after reset).
 	
 	// Don' merge with a vr capsule
-	if (bAllowMovementMerging && ClientData->PendingMove.IsValid() && !ClientData->PendingMove->bOldTimeStampBeforeReset && ClientData->PendingMove->CanCombineWith(NewMove, CharacterOwner, ClientData->MaxMoveDeltaTime * CharacterOwner->GetActorTimeDilation()))
+	bool bCombineMoves = false;
+	if (bAllowMovementMerging && ClientData->PendingMove.IsValid() && !ClientData->PendingMove->bOldTimeStampBeforeReset)
+	{
+		const float MaxCombineDelta = ClientData->MaxMoveDeltaTime * CharacterOwner->GetActorTimeDilation();
+		bCombineMoves = ClientData->PendingMove->CanCombineWith(NewMove, CharacterOwner, MaxCombineDelta);
+
+		if (!bCombineMoves && bAllowQuantizedMovementMerging)
+		{
+			bCombineMoves = ((FSavedMove_VRBaseCharacter *)ClientData->PendingMove.Get())->CanCombineWithQuantized(NewMove, CharacterOwner, MaxCombineDelta);
+
+			if (bCombineMoves)
+			{
+				INC_DWORD_STAT(STAT_CharQuantizedMovesCombinedVR);
+			}
+		}
+	}
+
+	if (bCombineMoves)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CharacterMovementCombineNetMove);
 
@@ -1544,6 +1650,12 @@ UVRCharacterMovementComponent::UVRCharacterMovementComponent(const FObjectInitia
 	WallRepulsionMultiplier = 0.01f;
 	bUseClientControlRotation = false;
 	bAllowMovementMerging = false;
+	bAllowQuantizedMovementMerging = false;
+	SavedMovePoolSize = 96;
+	bEnableServerMoveCoalescing = false;
+	bUseCharacterRepulsionGrid = false;
+	CharacterRepulsionStrength = 300.0f;
+	RepulsionGridIndex = INDEX_NONE;
 	bRequestedMoveUseAcceleration = false;
 }
 
@@ -1568,6 +1680,10 @@ void UVRCharacterMovementComponent::TickComponent(float DeltaTime, enum ELevelTi
 		}
 	}
 
+	UpdateSimulatedProxyRepulsion();
+
+	// Coalesce the overlap updates from every move this tick into one
+	FVRRootScopedOverlapDeferral ScopedOverlapDeferral(VRRootCapsule, VRRootCapsule && VRRootCapsule->bDeferOverlapUpdatesPerFrame);
 
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
@@ -1579,8 +1695,47 @@ bool UVRCharacterMovementComponent::CanCrouch()
 }
 
 
+void UVRCharacterMovementComponent::OnUnregister()
+{
+	FVRCharacterRepulsionManager::Unregister(this);
+	Super::OnUnregister();
+}
+
+void UVRCharacterMovementComponent::UpdateSimulatedProxyRepulsion()
+{
+	if (!CharacterOwner || CharacterOwner->Role != ROLE_SimulatedProxy)
+		return;
+
+	if (bUseCharacterRepulsionGrid && GetWorld())
+	{
+		FVRCharacterRepulsionManager::Get(GetWorld()).Register(this);
+	}
+	else if (RepulsionGridIndex != INDEX_NONE)
+	{
+		FVRCharacterRepulsionManager::Unregister(this);
+	}
+}
+
 void UVRCharacterMovementComponent::ApplyRepulsionForce(float DeltaSeconds)
 {
+	// Character vs character, simulated proxies only push (registered in UpdateSimulatedProxyRepulsion) and take the replicated result
+	const bool bIsSimulatedProxy = CharacterOwner != nullptr && CharacterOwner->Role == ROLE_SimulatedProxy;
+	if (bUseCharacterRepulsionGrid && CharacterOwner != nullptr && !bIsSimulatedProxy && GetWorld())
+	{
+		FVRCharacterRepulsionManager & RepulsionManager = FVRCharacterRepulsionManager::Get(GetWorld());
+		RepulsionManager.Register(this);
+
+		const FVector RepulsionVelocity = RepulsionManager.GetRepulsionVelocity(this);
+		if (!RepulsionVelocity.IsNearlyZero())
+		{
+			AddImpulse(RepulsionVelocity * DeltaSeconds, true);
+		}
+	}
+	else if (RepulsionGridIndex != INDEX_NONE && !(bUseCharacterRepulsionGrid && bIsSimulatedProxy))
+	{
+		FVRCharacterRepulsionManager::Unregister(this);
+	}
+
 	if (UpdatedPrimitive && RepulsionForce > 0.0f && CharacterOwner != nullptr)
 	{
 		const TArray<FOverlapInfo>& Overlaps = UpdatedPrimitive->GetOverlapInfos();
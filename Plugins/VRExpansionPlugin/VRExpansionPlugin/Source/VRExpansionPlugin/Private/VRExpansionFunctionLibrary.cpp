@@ -4,6 +4,9 @@
 #include "Engine/Engine.h"
 #include "IXRTrackingSystem.h"
 #include "IHeadMountedDisplay.h"
+#include "UObject/ObjectKey.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkinnedMeshComponent.h"
 
 #if WITH_EDITOR
 #include "Editor/UnrealEd/Classes/Editor/EditorEngine.h"
@@ -45,82 +48,178 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, A
 	if (!Actor)
 		return;
 
-	MaxRange = FMath::Square(MaxRange);
-
 	if (USceneComponent *rootComp = Actor->GetRootComponent())
 	{
-		FVector RelativeWorldLocation = rootComp->GetComponentTransform().InverseTransformPosition(WorldLocation);
-		float ClosestSlotDistance = -0.1f;
+		bHadSlotInRange = GetClosestGripSlotInRange(SlotType, rootComp, WorldLocation, MaxRange, SlotWorldTransform);
+	}
+}
+
+void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName SlotType, UPrimitiveComponent * Component, FVector WorldLocation, float MaxRange, bool & bHadSlotInRange, FTransform & SlotWorldTransform)
+{
+	bHadSlotInRange = false;
+	SlotWorldTransform = FTransform::Identity;
 
-		TArray<FName> SocketNames = rootComp->GetAllSocketNames();
+	if (!Component)
+		return;
 
-		FString GripIdentifier = SlotType.ToString();
+	bHadSlotInRange = GetClosestGripSlotInRange(SlotType, Component, WorldLocation, MaxRange, SlotWorldTransform);
+}
+
+namespace VRGripSlotCache
+{
+	// Sockets of a single slot type on a mesh asset
+	struct FSlotTable
+	{
+		TArray<FName> SocketNames;
 
-		int foundIndex = 0;
+		// Component space socket locations / transforms, only filled for static meshes as skeletal sockets move with the pose
+		TArray<FVector> ComponentSpaceLocations;
+		TArray<FTransform> ComponentSpaceTransforms;
+	};
+
+	typedef TPair<FObjectKey, FName> FSlotTableKey;
+	static TMap<FSlotTableKey, FSlotTable> SlotTables;
+
+	// Gathers the sockets whose name contains the slot type, in socket order
+	static void GatherSlotSockets(USceneComponent * Component, FName SlotType, TArray<FName> & OutSocketNames)
+	{
+		TArray<FName> SocketNames = Component->GetAllSocketNames();
+		FString GripIdentifier = SlotType.ToString();
 
 		for (int i = 0; i < SocketNames.Num(); ++i)
 		{
 			if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
 			{
-			
-				float vecLen = FVector::DistSquared(RelativeWorldLocation, rootComp->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
-
-				if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
-				{
-					ClosestSlotDistance = vecLen;
-					bHadSlotInRange = true;
-					foundIndex = i;
-				}
+				OutSocketNames.Add(SocketNames[i]);
 			}
 		}
+	}
 
-		if (bHadSlotInRange)
+	// Returns the slot table for the components mesh asset, building it on first use, or nullptr if the component has no mesh asset
+	static const FSlotTable * FindOrBuildSlotTable(USceneComponent * Component, FName SlotType)
+	{
+		UObject * MeshAsset = nullptr;
+		bool bStaticSockets = false;
+
+		if (UStaticMeshComponent * StaticMeshComp = Cast<UStaticMeshComponent>(Component))
 		{
-			SlotWorldTransform = rootComp->GetSocketTransform(SocketNames[foundIndex]);
-			SlotWorldTransform.SetScale3D(FVector(1.0f));
+			MeshAsset = StaticMeshComp->GetStaticMesh();
+			bStaticSockets = true;
 		}
+		else if (USkinnedMeshComponent * SkinnedMeshComp = Cast<USkinnedMeshComponent>(Component))
+		{
+			MeshAsset = SkinnedMeshComp->SkeletalMesh;
+		}
+
+		if (!MeshAsset)
+			return nullptr;
+
+		FSlotTableKey Key(FObjectKey(MeshAsset), SlotType);
+		if (const FSlotTable * FoundTable = SlotTables.Find(Key))
+			return FoundTable;
+
+#if WITH_EDITOR
+		// Sockets can be edited in the mesh editors, so drop everything whenever something changes
+		static bool bBoundEditorFlush = false;
+		if (!bBoundEditorFlush)
+		{
+			bBoundEditorFlush = true;
+			FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject *, FPropertyChangedEvent &) { SlotTables.Reset(); });
+		}
+#endif
+
+		FSlotTable & NewTable = SlotTables.Add(Key);
+		GatherSlotSockets(Component, SlotType, NewTable.SocketNames);
+
+		if (bStaticSockets)
+		{
+			NewTable.ComponentSpaceLocations.Reserve(NewTable.SocketNames.Num());
+			NewTable.ComponentSpaceTransforms.Reserve(NewTable.SocketNames.Num());
+			for (const FName & SocketName : NewTable.SocketNames)
+			{
+				FTransform SocketTransform = Component->GetSocketTransform(SocketName, ERelativeTransformSpace::RTS_Component);
+				NewTable.ComponentSpaceLocations.Add(SocketTransform.GetLocation());
+				NewTable.ComponentSpaceTransforms.Add(SocketTransform);
+			}
+		}
+
+		return &NewTable;
 	}
 }
 
-void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName SlotType, UPrimitiveComponent * Component, FVector WorldLocation, float MaxRange, bool & bHadSlotInRange, FTransform & SlotWorldTransform)
+bool UVRExpansionFunctionLibrary::GetClosestGripSlotInRange(FName SlotType, USceneComponent * Component, FVector WorldLocation, float MaxRange, FTransform & SlotWorldTransform)
 {
-	bHadSlotInRange = false;
 	SlotWorldTransform = FTransform::Identity;
 
 	if (!Component)
-		return;
+		return false;
 
-	FVector RelativeWorldLocation = Component->GetComponentTransform().InverseTransformPosition(WorldLocation);
+	const FTransform & ComponentTransform = Component->GetComponentTransform();
+	FVector RelativeWorldLocation = ComponentTransform.InverseTransformPosition(WorldLocation);
 	MaxRange = FMath::Square(MaxRange);
 
 	float ClosestSlotDistance = -0.1f;
+	int foundIndex = INDEX_NONE;
 
-	TArray<FName> SocketNames = Component->GetAllSocketNames();
+	const VRGripSlotCache::FSlotTable * SlotTable = VRGripSlotCache::FindOrBuildSlotTable(Component, SlotType);
 
-	FString GripIdentifier = SlotType.ToString();
-
-	int foundIndex = 0;
-
-	for (int i = 0; i < SocketNames.Num(); ++i)
+	// Static sockets never move relative to the component, so check against the cached locations directly
+	if (SlotTable && SlotTable->ComponentSpaceLocations.Num() == SlotTable->SocketNames.Num())
 	{
-		if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+		const FVector * SlotLocations = SlotTable->ComponentSpaceLocations.GetData();
+		for (int i = 0; i < SlotTable->ComponentSpaceLocations.Num(); ++i)
 		{
-			float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
+			float vecLen = FVector::DistSquared(RelativeWorldLocation, SlotLocations[i]);
 
 			if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
 			{
 				ClosestSlotDistance = vecLen;
-				bHadSlotInRange = true;
 				foundIndex = i;
 			}
 		}
+
+		if (foundIndex != INDEX_NONE)
+		{
+			SlotWorldTransform = SlotTable->ComponentSpaceTransforms[foundIndex] * ComponentTransform;
+			SlotWorldTransform.SetScale3D(FVector(1.0f));
+			return true;
+		}
+
+		return false;
+	}
+
+	// Otherwise use the cached slot names if we have them, or search the socket names
+	TArray<FName> GatheredSocketNames;
+	if (!SlotTable)
+	{
+		VRGripSlotCache::GatherSlotSockets(Component, SlotType, GatheredSocketNames);
+	}
+	const TArray<FName> & SocketNames = SlotTable ? SlotTable->SocketNames : GatheredSocketNames;
+
+	for (int i = 0; i < SocketNames.Num(); ++i)
+	{
+		float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
+
+		if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
+		{
+			ClosestSlotDistance = vecLen;
+			foundIndex = i;
+		}
 	}
 
-	if (bHadSlotInRange)
+	if (foundIndex != INDEX_NONE)
 	{
 		SlotWorldTransform = Component->GetSocketTransform(SocketNames[foundIndex]);
 		SlotWorldTransform.SetScale3D(FVector(1.0f));
+		return true;
 	}
+
+	return false;
+}
+
+void UVRExpansionFunctionLibrary::ClearGripSlotCache()
+{
+	VRGripSlotCache::SlotTables.Reset();
 }
 
 FRotator UVRExpansionFunctionLibrary::GetHMDPureYaw(FRotator HMDRotation)
@@ -243,17 +342,67 @@ bool UVRExpansionFunctionLibrary::IsInVREditorPreview()
 	return false;
 }
 
+namespace VRMinimumAreaRectangle
+{
+	FORCEINLINE float Cross(const FVector2D & O, const FVector2D & A, const FVector2D & B)
+	{
+		return (A.X - O.X) * (B.Y - O.Y) - (A.Y - O.Y) * (B.X - O.X);
+	}
+
+	// Andrew's monotone chain, O(n log n), outputs the hull counter clockwise without collinear or duplicate points
+	static void ComputeConvexHull(const TArray<FVector2D> & Points, TArray<FVector2D> & OutHull)
+	{
+		OutHull.Reset();
+
+		TArray<FVector2D> Sorted = Points;
+		Sorted.Sort([](const FVector2D & A, const FVector2D & B)
+		{
+			return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+		});
+
+		// Drop exact duplicates so that a hull of identical points doesn't end up with zero length edges
+		int32 NumUnique = 0;
+		for (int i = 0; i < Sorted.Num(); i++)
+		{
+			if (NumUnique == 0 || Sorted[i] != Sorted[NumUnique - 1])
+				Sorted[NumUnique++] = Sorted[i];
+		}
+		Sorted.SetNum(NumUnique, false);
+
+		if (NumUnique < 3)
+		{
+			OutHull = Sorted;
+			return;
+		}
+
+		OutHull.SetNumUninitialized(NumUnique * 2);
+		int32 k = 0;
+
+		// Lower hull
+		for (int i = 0; i < NumUnique; i++)
+		{
+			while (k >= 2 && Cross(OutHull[k - 2], OutHull[k - 1], Sorted[i]) <= 0.f)
+				k--;
+			OutHull[k++] = Sorted[i];
+		}
+
+		// Upper hull
+		for (int i = NumUnique - 2, LowerSize = k + 1; i >= 0; i--)
+		{
+			while (k >= LowerSize && Cross(OutHull[k - 2], OutHull[k - 1], Sorted[i]) <= 0.f)
+				k--;
+			OutHull[k++] = Sorted[i];
+		}
+
+		// Last point is the same as the first
+		OutHull.SetNum(k - 1, false);
+	}
+}
+
 void UVRExpansionFunctionLibrary::NonAuthorityMinimumAreaRectangle(class UObject* WorldContextObject, const TArray<FVector>& InVerts, const FVector& SampleSurfaceNormal, FVector& OutRectCenter, FRotator& OutRectRotation, float& OutSideLengthX, float& OutSideLengthY, bool bDebugDraw)
 {
-	float MinArea = -1.f;
-	float CurrentArea = -1.f;
-	FVector SupportVectorA, SupportVectorB;
-	FVector RectSideA, RectSideB;
-	float MinDotResultA, MinDotResultB, MaxDotResultA, MaxDotResultB;
-	FVector TestEdge;
-	float TestEdgeDot = 0.f;
+	FVector RectSideA(0.f), RectSideB(0.f);
 	FVector PolyNormal(0.f, 0.f, 1.f);
-	TArray<int32> PolyVertIndices;
 
 	// Bail if we receive an empty InVerts array
 	if (InVerts.Num() == 0)
@@ -263,71 +412,91 @@ void UVRExpansionFunctionLibrary::NonAuthorityMinimumAreaRectangle(class UObject
 
 	// Compute the approximate normal of the poly, using the direction of SampleSurfaceNormal for guidance
 	PolyNormal = (InVerts[InVerts.Num() / 3] - InVerts[0]) ^ (InVerts[InVerts.Num() * 2 / 3] - InVerts[InVerts.Num() / 3]);
-	if ((PolyNormal | SampleSurfaceNormal) < 0.f)
+	if (PolyNormal.IsNearlyZero())
+	{
+		// Too few or collinear samples, fall back to the sample normal
+		PolyNormal = SampleSurfaceNormal.IsNearlyZero() ? FVector(0.f, 0.f, 1.f) : SampleSurfaceNormal;
+	}
+	else if ((PolyNormal | SampleSurfaceNormal) < 0.f)
 	{
 		PolyNormal = -PolyNormal;
 	}
 
 	// Transform the sample points to 2D
 	FMatrix SurfaceNormalMatrix = FRotationMatrix::MakeFromZX(PolyNormal, FVector(1.f, 0.f, 0.f));
-	TArray<FVector> TransformedVerts;
-	OutRectCenter = FVector(0.f);
+	TArray<FVector2D> TransformedVerts;
+	TransformedVerts.Reserve(InVerts.Num());
+	float AverageHeight = 0.f;
 	for (int32 Idx = 0; Idx < InVerts.Num(); ++Idx)
 	{
-		OutRectCenter += InVerts[Idx];
-		TransformedVerts.Add(SurfaceNormalMatrix.InverseTransformVector(InVerts[Idx]));
+		FVector TransformedVert = SurfaceNormalMatrix.InverseTransformVector(InVerts[Idx]);
+		TransformedVerts.Add(FVector2D(TransformedVert.X, TransformedVert.Y));
+		AverageHeight += TransformedVert.Z;
 	}
-	OutRectCenter /= InVerts.Num();
+	AverageHeight /= InVerts.Num();
 
 	// Compute the convex hull of the sample points
-	ConvexHull2D::ComputeConvexHull(TransformedVerts, PolyVertIndices);
-
-	// Minimum area rectangle as computed by http://www.geometrictools.com/Documentation/MinimumAreaRectangle.pdf
-	for (int32 Idx = 1; Idx < PolyVertIndices.Num() - 1; ++Idx)
+	TArray<FVector2D> Hull;
+	VRMinimumAreaRectangle::ComputeConvexHull(TransformedVerts, Hull);
+	const int32 NumHullVerts = Hull.Num();
+
+	// Minimum area rectangle has a side collinear with one of the hull edges
+	// Rotating calipers: the extreme points for each edge only ever move forward around the hull so the search is O(h)
+	FVector2D RectCenter2D = Hull[0];
+	if (NumHullVerts > 1)
 	{
-		SupportVectorA = (TransformedVerts[PolyVertIndices[Idx]] - TransformedVerts[PolyVertIndices[Idx - 1]]).GetSafeNormal();
-		SupportVectorA.Z = 0.f;
-		SupportVectorB.X = -SupportVectorA.Y;
-		SupportVectorB.Y = SupportVectorA.X;
-		SupportVectorB.Z = 0.f;
-		MinDotResultA = MinDotResultB = MaxDotResultA = MaxDotResultB = 0.f;
-
-		for (int TestVertIdx = 1; TestVertIdx < PolyVertIndices.Num(); ++TestVertIdx)
+		float MinArea = -1.f;
+		int32 MaxUIdx = 0, MaxVIdx = 0, MinUIdx = 0;
+
+		for (int32 Idx = 0; Idx < NumHullVerts; ++Idx)
 		{
-			TestEdge = TransformedVerts[PolyVertIndices[TestVertIdx]] - TransformedVerts[PolyVertIndices[0]];
-			TestEdgeDot = SupportVectorA | TestEdge;
-			if (TestEdgeDot < MinDotResultA)
+			const FVector2D & EdgeStart = Hull[Idx];
+			const FVector2D U = (Hull[(Idx + 1) % NumHullVerts] - EdgeStart).GetSafeNormal();
+			const FVector2D V(-U.Y, U.X); // Inwards for a counter clockwise hull
+
+			if (Idx == 0)
 			{
-				MinDotResultA = TestEdgeDot;
+				// Seed the calipers with a full scan on the first edge
+				for (int32 TestIdx = 1; TestIdx < NumHullVerts; ++TestIdx)
+				{
+					if ((Hull[TestIdx] | U) > (Hull[MaxUIdx] | U))
+						MaxUIdx = TestIdx;
+					if ((Hull[TestIdx] | V) > (Hull[MaxVIdx] | V))
+						MaxVIdx = TestIdx;
+					if ((Hull[TestIdx] | U) < (Hull[MinUIdx] | U))
+						MinUIdx = TestIdx;
+				}
 			}
-			else if (TestEdgeDot > MaxDotResultA)
+			else
 			{
-				MaxDotResultA = TestEdgeDot;
+				while ((Hull[(MaxUIdx + 1) % NumHullVerts] | U) > (Hull[MaxUIdx] | U))
+					MaxUIdx = (MaxUIdx + 1) % NumHullVerts;
+				while ((Hull[(MaxVIdx + 1) % NumHullVerts] | V) > (Hull[MaxVIdx] | V))
+					MaxVIdx = (MaxVIdx + 1) % NumHullVerts;
+				while ((Hull[(MinUIdx + 1) % NumHullVerts] | U) < (Hull[MinUIdx] | U))
+					MinUIdx = (MinUIdx + 1) % NumHullVerts;
 			}
 
-			TestEdgeDot = SupportVectorB | TestEdge;
-			if (TestEdgeDot < MinDotResultB)
-			{
-				MinDotResultB = TestEdgeDot;
-			}
-			else if (TestEdgeDot > MaxDotResultB)
+			const float MinU = Hull[MinUIdx] | U;
+			const float MaxU = Hull[MaxUIdx] | U;
+			const float MinV = EdgeStart | V;
+			const float MaxV = Hull[MaxVIdx] | V;
+
+			const float CurrentArea = (MaxU - MinU) * (MaxV - MinV);
+			if (MinArea < 0.f || CurrentArea < MinArea)
 			{
-				MaxDotResultB = TestEdgeDot;
+				MinArea = CurrentArea;
+				RectSideA = FVector(U * (MaxU - MinU), 0.f);
+				RectSideB = FVector(V * (MaxV - MinV), 0.f);
+				RectCenter2D = U * ((MinU + MaxU) * 0.5f) + V * ((MinV + MaxV) * 0.5f);
 			}
 		}
-
-		CurrentArea = (MaxDotResultA - MinDotResultA) * (MaxDotResultB - MinDotResultB);
-		if (MinArea < 0.f || CurrentArea < MinArea)
-		{
-			MinArea = CurrentArea;
-			RectSideA = SupportVectorA * (MaxDotResultA - MinDotResultA);
-			RectSideB = SupportVectorB * (MaxDotResultB - MinDotResultB);
-		}
 	}
 
+	OutRectCenter = SurfaceNormalMatrix.TransformVector(FVector(RectCenter2D, AverageHeight));
 	RectSideA = SurfaceNormalMatrix.TransformVector(RectSideA);
 	RectSideB = SurfaceNormalMatrix.TransformVector(RectSideB);
-	OutRectRotation = FRotationMatrix::MakeFromZX(PolyNormal, RectSideA).Rotator();
+	OutRectRotation = FRotationMatrix::MakeFromZX(PolyNormal, RectSideA.IsNearlyZero() ? SurfaceNormalMatrix.GetUnitAxis(EAxis::X) : RectSideA).Rotator();
 	OutSideLengthX = RectSideA.Size();
 	OutSideLengthY = RectSideB.Size();
 
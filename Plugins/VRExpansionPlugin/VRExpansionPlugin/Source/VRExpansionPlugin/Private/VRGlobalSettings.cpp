@@ -9,7 +9,9 @@ UVRGlobalSettings::UVRGlobalSettings(const FObjectInitializer& ObjectInitializer
 	CurrentControllerProfileTransformRight(FTransform::Identity),
 	OneEuroMinCutoff(2.0f),
 	OneEuroCutoffSlope(0.007f),
-	OneEuroDeltaCutoff(1.0f)
+	OneEuroDeltaCutoff(1.0f),
+	HMDPoseFilterSettings(1.0f, 0.007f, 1.0f, 0.05f, 0.1f),
+	ControllerPoseFilterSettings(1.5f, 0.01f, 1.0f, 0.05f, 0.15f)
 
 {
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "DrawDebugHelpers.h"
 #include "IHeadMountedDisplay.h"
 #include "VRCharacter.h"
+#include "VRPoseFilterStage.h"
 
 #if WITH_PHYSX
 #include "PhysXSupport.h"
@@ -18,8 +19,14 @@ DEFINE_LOG_CATEGORY(LogVRRootComponent);
 #define LOCTEXT_NAMESPACE "VRRootComponent"
 
 DECLARE_CYCLE_STAT(TEXT("VRRootMovement"), STAT_VRRootMovement, STATGROUP_VRRootComponent);
-
-typedef TArray<FOverlapInfo, TInlineAllocator<3>> TInlineOverlapInfoArray;
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Relative Sweeps"), STAT_VRRootRelativeSweeps, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Relative Async Sweeps"), STAT_VRRootRelativeAsyncSweeps, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Relative Updates Skipped"), STAT_VRRootRelativeUpdatesSkipped, STATGROUP_VRRootComponent);
+DECLARE_CYCLE_STAT(TEXT("VR Root Update Overlaps"), STAT_VRRootUpdateOverlaps, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlap Updates"), STAT_VRRootOverlapUpdates, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlap Queries"), STAT_VRRootOverlapQueries, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlaps Found"), STAT_VRRootOverlapsFound, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VR Root Overlap Updates Deferred"), STAT_VRRootOverlapUpdatesDeferred, STATGROUP_VRRootComponent);
 
 FORCEINLINE_DEBUGGABLE static bool CanComponentsGenerateOverlap(const UPrimitiveComponent* MyComponent, /*const*/ UPrimitiveComponent* OtherComp)
 {
@@ -274,6 +281,21 @@ UVRRootComponent::UVRRootComponent(const FObjectInitializer& ObjectInitializer)
 	bUseWalkingCollisionOverride = false;
 	WalkingCollisionOverride = ECollisionChannel::ECC_Pawn;
 
+	bAccumulateHMDMovement = false;
+	HMDMovementThreshold = 0.1f;
+	HMDRotationThreshold = 0.1f;
+	bUseSharedPoseFilter = false;
+	bUseAsyncWalkingCollisionSweep = false;
+	bRelativeMovementSweepParamsDirty = true;
+	RelativeMovementSweepIgnoreCount = 0;
+	PendingAsyncSweepStart = FVector::ZeroVector;
+	PendingAsyncSweepDelta = FVector::ZeroVector;
+
+	bDeferOverlapUpdatesPerFrame = false;
+	OverlapDeferralDepth = 0;
+	bDeferredOverlapUpdatePending = false;
+	bDeferredOverlapsValidAtEnd = true;
+
 	bCalledUpdateTransform = false;
 
 	CanCharacterStepUpOn = ECB_No;
@@ -414,6 +436,8 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 	if (IsLocallyControlled())
 	{
+		bool bFilteredPoseHeld = false;
+
 		if (OptionalWaistTrackingParent.IsValid())
 		{
 			FTransform NewTrans = IVRTrackedParentInterface::Default_GetWaistOrientationAndPosition(OptionalWaistTrackingParent);
@@ -423,7 +447,21 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 		else if (GEngine->XRSystem.IsValid() && GEngine->XRSystem->IsHeadTrackingAllowed())
 		{
 			FQuat curRot;
-			if (!GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, curRot, curCameraLoc))
+			if (bUseSharedPoseFilter)
+			{
+				bool bFilteredPoseMoved = true;
+				if (!FVRPoseFilterStage::GetFilteredHMDPose(curRot, curCameraLoc, bFilteredPoseMoved))
+				{
+					curCameraLoc = lastCameraLoc;
+					curCameraRot = lastCameraRot;
+				}
+				else
+				{
+					curCameraRot = curRot.Rotator();
+					bFilteredPoseHeld = !bFilteredPoseMoved;
+				}
+			}
+			else if (!GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, curRot, curCameraLoc))
 			{
 				curCameraLoc = lastCameraLoc;
 				curCameraRot = lastCameraRot;
@@ -442,11 +480,71 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 			curCameraLoc = FVector::ZeroVector;
 		}
 
+		bool bHMDMoved = true;
+
+		if (bFilteredPoseHeld)
+		{
+			// Filter is holding the last pose, the noise was inside of its deadband
+			curCameraLoc = lastCameraLoc;
+			curCameraRot = lastCameraRot;
+			bHMDMoved = false;
+		}
+		else if (bAccumulateHMDMovement)
+		{
+			// Hold the last pose until the HMD has moved far enough, the held back movement gets swept all at once
+			if (curCameraLoc.Equals(lastCameraLoc, HMDMovementThreshold) && curCameraRot.Equals(lastCameraRot, HMDRotationThreshold))
+			{
+				curCameraLoc = lastCameraLoc;
+				curCameraRot = lastCameraRot;
+				bHMDMoved = false;
+			}
+		}
+		// Can adjust the relative tolerances to remove jitter and some update processing
+		else if (curCameraLoc.Equals(lastCameraLoc, 0.01f) && curCameraRot.Equals(lastCameraRot, 0.01f))
+		{
+			bHMDMoved = false;
+		}
+
 		// Store a leveled yaw value here so it is only calculated once
 		StoredCameraRotOffset = UVRExpansionFunctionLibrary::GetHMDPureYaw_I(curCameraRot);
 
-		// Can adjust the relative tolerances to remove jitter and some update processing
-		if (!curCameraLoc.Equals(lastCameraLoc, 0.01f) || !curCameraRot.Equals(lastCameraRot, 0.01f))
+		// Pick up the async sweep from last frame, if it hit then its movement is applied now
+		// Its delta is copied off as issuing this frames sweep overwrites the pending one
+		bool bHadAsyncBlockingHit = false;
+		FVector AsyncSweepDelta = FVector::ZeroVector;
+		if (RelativeMovementAsyncSweepHandle.IsValid())
+		{
+			AsyncSweepDelta = PendingAsyncSweepDelta;
+
+			FTraceDatum SweepData;
+			if (GetWorld()->QueryTraceData(RelativeMovementAsyncSweepHandle, SweepData))
+			{
+				for (int i = 0; i < SweepData.OutHits.Num(); i++)
+				{
+					if (SweepData.OutHits[i].bBlockingHit && SweepData.OutHits[i].Component.IsValid())
+					{
+						bHadAsyncBlockingHit = ShouldBlockRelativeMovement(SweepData.OutHits[i], CharMove);
+						break;
+					}
+				}
+			}
+			else
+			{
+				// Result is gone (trace data flushed or world re-ticked), redo the sweep here rather than lose a hit
+				UE_LOG(LogVRRootComponent, Warning, TEXT("%s->%s Async relative movement sweep result was not found, falling back to a sync sweep"), *GetNameSafe(GetOwner()), *GetName());
+
+				UpdateRelativeMovementSweepParams();
+				INC_DWORD_STAT(STAT_VRRootRelativeSweeps);
+				FHitResult FallbackHit;
+				if (GetWorld()->SweepSingleByChannel(FallbackHit, PendingAsyncSweepStart, PendingAsyncSweepStart + AsyncSweepDelta, FQuat::Identity, WalkingCollisionOverride, GetCollisionShape(), RelativeMovementSweepParams, RelativeMovementResponseParams) && FallbackHit.Component.IsValid())
+					bHadAsyncBlockingHit = ShouldBlockRelativeMovement(FallbackHit, CharMove);
+			}
+
+			RelativeMovementAsyncSweepHandle = FTraceHandle();
+			PendingAsyncSweepDelta = FVector::ZeroVector;
+		}
+
+		if (bHMDMoved)
 		{
 			// Also calculate vector of movement for the movement component
 			FVector LastPosition = OffsetComponentToWorld.GetLocation();
@@ -465,11 +563,6 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 			}
 
 			FHitResult OutHit;
-			FCollisionQueryParams Params("RelativeMovementSweep", false, GetOwner());
-			FCollisionResponseParams ResponseParam;
-
-			InitSweepCollisionParams(Params, ResponseParam);
-			Params.bFindInitialOverlaps = true;
 			bool bBlockingHit = false;
 
 
@@ -483,15 +576,25 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 				}
 
 				if (bAllowWalkingCollision)
-					bBlockingHit = GetWorld()->SweepSingleByChannel(OutHit, LastPosition, OffsetComponentToWorld.GetLocation(), FQuat::Identity, WalkingCollisionOverride, GetCollisionShape(), Params, ResponseParam);
-
-				if (bBlockingHit && OutHit.Component.IsValid())
 				{
-					if (CharMove != nullptr && CharMove->bIgnoreSimulatingComponentsInFloorCheck && OutHit.Component->IsSimulatingPhysics())
-						bHadRelativeMovement = false;
+					UpdateRelativeMovementSweepParams();
+
+					if (bUseAsyncWalkingCollisionSweep)
+					{
+						INC_DWORD_STAT(STAT_VRRootRelativeAsyncSweeps);
+						RelativeMovementAsyncSweepHandle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, LastPosition, OffsetComponentToWorld.GetLocation(), WalkingCollisionOverride, GetCollisionShape(), RelativeMovementSweepParams, RelativeMovementResponseParams);
+						PendingAsyncSweepStart = LastPosition;
+						PendingAsyncSweepDelta = OffsetComponentToWorld.GetLocation() - LastPosition;
+					}
 					else
-						bHadRelativeMovement = true;
+					{
+						INC_DWORD_STAT(STAT_VRRootRelativeSweeps);
+						bBlockingHit = GetWorld()->SweepSingleByChannel(OutHit, LastPosition, OffsetComponentToWorld.GetLocation(), FQuat::Identity, WalkingCollisionOverride, GetCollisionShape(), RelativeMovementSweepParams, RelativeMovementResponseParams);
+					}
 				}
+
+				if (bBlockingHit && OutHit.Component.IsValid())
+					bHadRelativeMovement = ShouldBlockRelativeMovement(OutHit, CharMove);
 				else
 					bHadRelativeMovement = false;
 			}
@@ -500,19 +603,31 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 
 			if (bHadRelativeMovement)
 			{
-				DifferenceFromLastFrame = (OffsetComponentToWorld.GetLocation() - LastPosition);// .GetSafeNormal2D();
-				DifferenceFromLastFrame.X = FMath::RoundToFloat(DifferenceFromLastFrame.X * 100.f) / 100.f;
-				DifferenceFromLastFrame.Y = FMath::RoundToFloat(DifferenceFromLastFrame.Y * 100.f) / 100.f;
-				DifferenceFromLastFrame.Z = 0.0f; // Reset Z to zero, its not used anyway and this lets me reuse the Z component for capsule half height
+				SetRelativeMovementDifference(OffsetComponentToWorld.GetLocation() - LastPosition);
 			}
 			else // Zero it out so we don't process off of the change (multiplayer sends this)
 				DifferenceFromLastFrame = FVector::ZeroVector;
+
+			if (bAccumulateHMDMovement || bUseSharedPoseFilter)
+			{
+				lastCameraRot = curCameraRot;
+				lastCameraLoc = curCameraLoc;
+			}
 		}
 		else
 		{
+			INC_DWORD_STAT(STAT_VRRootRelativeUpdatesSkipped);
 			bHadRelativeMovement = false;
 			DifferenceFromLastFrame = FVector::ZeroVector;
 		}
+
+		// Last frames async sweep hit, push back with the movement that it was testing
+		// Added onto anything from this frame so that neither is lost
+		if (bHadAsyncBlockingHit)
+		{
+			SetRelativeMovementDifference(DifferenceFromLastFrame + AsyncSweepDelta);
+			bHadRelativeMovement = true;
+		}
 	}
 	else
 	{
@@ -555,6 +670,46 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 }
 
 
+void UVRRootComponent::UpdateRelativeMovementSweepParams()
+{
+	// Ignore lists can be changed without a collision settings change, so check their size as well
+	const int32 IgnoreCount = MoveIgnoreActors.Num() + MoveIgnoreComponents.Num();
+
+	if (!bRelativeMovementSweepParamsDirty && IgnoreCount == RelativeMovementSweepIgnoreCount)
+		return;
+
+	RelativeMovementSweepParams = FCollisionQueryParams("RelativeMovementSweep", false, GetOwner());
+	RelativeMovementResponseParams = FCollisionResponseParams();
+
+	InitSweepCollisionParams(RelativeMovementSweepParams, RelativeMovementResponseParams);
+	RelativeMovementSweepParams.bFindInitialOverlaps = true;
+
+	RelativeMovementSweepIgnoreCount = IgnoreCount;
+	bRelativeMovementSweepParamsDirty = false;
+}
+
+void UVRRootComponent::OnComponentCollisionSettingsChanged()
+{
+	Super::OnComponentCollisionSettingsChanged();
+	bRelativeMovementSweepParamsDirty = true;
+}
+
+bool UVRRootComponent::ShouldBlockRelativeMovement(const FHitResult & Hit, UVRBaseCharacterMovementComponent * CharMove) const
+{
+	if (CharMove != nullptr && CharMove->bIgnoreSimulatingComponentsInFloorCheck && Hit.Component.IsValid() && Hit.Component->IsSimulatingPhysics())
+		return false;
+
+	return true;
+}
+
+void UVRRootComponent::SetRelativeMovementDifference(const FVector & Delta)
+{
+	DifferenceFromLastFrame = Delta;// .GetSafeNormal2D();
+	DifferenceFromLastFrame.X = FMath::RoundToFloat(DifferenceFromLastFrame.X * 100.f) / 100.f;
+	DifferenceFromLastFrame.Y = FMath::RoundToFloat(DifferenceFromLastFrame.Y * 100.f) / 100.f;
+	DifferenceFromLastFrame.Z = 0.0f; // Reset Z to zero, its not used anyway and this lets me reuse the Z component for capsule half height
+}
+
 void UVRRootComponent::SendPhysicsTransform(ETeleportType Teleport)
 {
 	BodyInstance.SetBodyTransform(OffsetComponentToWorld, Teleport);
@@ -899,8 +1054,8 @@ bool UVRRootComponent::MoveComponentImpl(const FVector& Delta, const FQuat& NewR
 		{
 			if (bIncludesOverlapsAtEnd)
 			{
-				TArray<FOverlapInfo> OverlapsAtEndLocation;
-				const TArray<FOverlapInfo>* OverlapsAtEndLocationPtr = nullptr; // When non-null, used as optimization to avoid work in UpdateOverlaps.
+				TInlineOverlapInfoArray OverlapsAtEndLocation;
+				const TInlineOverlapInfoArray* OverlapsAtEndLocationPtr = nullptr; // When non-null, used as optimization to avoid work in UpdateOverlaps.
 				if (bRotationOnly)
 				{
 					OverlapsAtEndLocationPtr = ConvertRotationOverlapsToCurrentOverlaps(OverlapsAtEndLocation, GetOverlapInfos());
@@ -910,11 +1065,11 @@ bool UVRRootComponent::MoveComponentImpl(const FVector& Delta, const FQuat& NewR
 					OverlapsAtEndLocationPtr = ConvertSweptOverlapsToCurrentOverlaps(OverlapsAtEndLocation, PendingOverlaps, 0, /*GetComponentLocation()*/OffsetComponentToWorld.GetLocation(), GetComponentQuat());
 				}
 
-				UpdateOverlaps(&PendingOverlaps, true, OverlapsAtEndLocationPtr);
+				UpdateOverlapsImpl(&PendingOverlaps, true, OverlapsAtEndLocationPtr);
 			}
 			else
 			{
-				UpdateOverlaps(&PendingOverlaps, true, nullptr);
+				UpdateOverlapsImpl(&PendingOverlaps, true, nullptr);
 			}
 		}
 	}
@@ -952,9 +1107,82 @@ bool UVRRootComponent::MoveComponentImpl(const FVector& Delta, const FQuat& NewR
 	return bMoved;
 }
 
+FVRRootScopedOverlapDeferral::FVRRootScopedOverlapDeferral(UVRRootComponent * InRoot, bool bEnabled)
+	: Root(bEnabled ? InRoot : nullptr)
+{
+	if (Root)
+	{
+		Root->OverlapDeferralDepth++;
+	}
+}
+
+FVRRootScopedOverlapDeferral::~FVRRootScopedOverlapDeferral()
+{
+	if (Root)
+	{
+		check(Root->OverlapDeferralDepth > 0);
+		if (--Root->OverlapDeferralDepth == 0)
+		{
+			Root->FlushDeferredOverlaps();
+		}
+	}
+}
+
+void UVRRootComponent::FlushDeferredOverlaps()
+{
+	if (!bDeferredOverlapUpdatePending || IsPendingKill())
+	{
+		bDeferredOverlapUpdatePending = false;
+		DeferredPendingOverlaps.Reset();
+		return;
+	}
+
+	bDeferredOverlapUpdatePending = false;
+
+	// Move out so that overlap events moving us again don't modify the list while it is in use
+	TArray<FOverlapInfo> PendingOverlaps = MoveTemp(DeferredPendingOverlaps);
+	DeferredPendingOverlaps.Reset();
+
+	if (bDeferredOverlapsValidAtEnd)
+	{
+		// Every move knew its end overlaps were inside of its swept overlaps, so the end overlaps are inside of
+		// all of the swept overlaps plus whatever we were overlapping before the first move.
+		// Beginning an overlap we already have does nothing, so these can just go into the pending list.
+		if (AActor * MyActor = GetOwner())
+		{
+			for (const FOverlapInfo & Overlap : GetOverlapInfos())
+			{
+				if (FPredicateOverlapHasDifferentActor(*MyActor)(Overlap))
+					PendingOverlaps.AddUnique(Overlap);
+			}
+		}
+	}
+
+	UpdateOverlapsImpl(&PendingOverlaps, true, nullptr, !bDeferredOverlapsValidAtEnd);
+	bDeferredOverlapsValidAtEnd = true;
+
+	// Keep the allocation around for the next frame if nothing was deferred during the flush
+	if (DeferredPendingOverlaps.Num() == 0)
+	{
+		PendingOverlaps.Reset();
+		DeferredPendingOverlaps = MoveTemp(PendingOverlaps);
+	}
+}
+
 void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOverlaps, bool bDoNotifies, const TArray<FOverlapInfo>* OverlapsAtEndLocation)
 {
-	//SCOPE_CYCLE_COUNTER(STAT_UpdateOverlaps);
+	if (OverlapsAtEndLocation)
+	{
+		TInlineOverlapInfoArray EndOverlaps;
+		EndOverlaps.Append(*OverlapsAtEndLocation);
+		UpdateOverlapsImpl(NewPendingOverlaps, bDoNotifies, &EndOverlaps);
+	}
+	else
+		UpdateOverlapsImpl(NewPendingOverlaps, bDoNotifies, nullptr);
+}
+
+void UVRRootComponent::UpdateOverlapsImpl(const TArray<FOverlapInfo>* NewPendingOverlaps, bool bDoNotifies, const TInlineOverlapInfoArray* OverlapsAtEndLocation, bool bForceOverlapQuery)
+{
 	if (IsDeferringMovementUpdates())
 	{
 		// Someone tried to call UpdateOverlaps() explicitly during a deferred update, this means they really have a good reason to force it.
@@ -962,6 +1190,27 @@ void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOver
 		return;
 	}
 
+	if (OverlapDeferralDepth > 0)
+	{
+		INC_DWORD_STAT(STAT_VRRootOverlapUpdatesDeferred);
+
+		if (NewPendingOverlaps)
+		{
+			for (const FOverlapInfo & Overlap : *NewPendingOverlaps)
+				DeferredPendingOverlaps.AddUnique(Overlap);
+		}
+
+		// Without a known end state we have to query at the end of the scope
+		if (!OverlapsAtEndLocation || bForceOverlapQuery)
+			bDeferredOverlapsValidAtEnd = false;
+
+		bDeferredOverlapUpdatePending = true;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_VRRootUpdateOverlaps);
+	INC_DWORD_STAT(STAT_VRRootOverlapUpdates);
+
 	// first, dispatch any pending overlaps
 	if (bGenerateOverlapEvents && IsQueryCollisionEnabled())
 	{
@@ -984,14 +1233,18 @@ void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOver
 				}
 			}
 
-			const TArray<FOverlapInfo>* OverlapsAtEndLocationPtr;
+			const TInlineOverlapInfoArray* OverlapsAtEndLocationPtr;
 
 			// TODO: Filter this better so it runs even less often?
 			// Its not that bad currently running off of NewPendingOverlaps
 			// It forces checking for end location overlaps again if none are registered, just in case
 			// the capsule isn't setting things correctly.
-			TArray<FOverlapInfo> OverlapsAtEnd;
-			if ((!OverlapsAtEndLocation || OverlapsAtEndLocation->Num() < 1) && NewPendingOverlaps && NewPendingOverlaps->Num() > 0)
+			TInlineOverlapInfoArray OverlapsAtEnd;
+			if (bForceOverlapQuery)
+			{
+				OverlapsAtEndLocationPtr = nullptr;
+			}
+			else if ((!OverlapsAtEndLocation || OverlapsAtEndLocation->Num() < 1) && NewPendingOverlaps && NewPendingOverlaps->Num() > 0)
 			{
 				OverlapsAtEndLocationPtr = ConvertSweptOverlapsToCurrentOverlaps(OverlapsAtEnd, *NewPendingOverlaps, 0, OffsetComponentToWorld.GetLocation(), GetComponentQuat());
 			}
@@ -1023,6 +1276,7 @@ void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOver
 				else
 				{
 					UE_LOG(LogVRRootComponent, VeryVerbose, TEXT("%s->%s Performing overlaps!"), *GetNameSafe(GetOwner()), *GetName());
+					INC_DWORD_STAT(STAT_VRRootOverlapQueries);
 					UWorld* const MyWorld = MyActor->GetWorld();
 					TArray<FOverlapResult> Overlaps;
 					// note this will optionally include overlaps with components in the same actor (depending on bIgnoreChildren). 
@@ -1096,6 +1350,8 @@ void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOver
 				}
 			}
 
+			INC_DWORD_STAT_BY(STAT_VRRootOverlapsFound, NewOverlappingComponents.Num());
+
 			// NewOverlappingComponents now contains only new overlaps that didn't exist previously.
 			for (auto CompIt = NewOverlappingComponents.CreateIterator(); CompIt; ++CompIt)
 			{
@@ -1138,13 +1394,13 @@ void UVRRootComponent::UpdateOverlaps(const TArray<FOverlapInfo>* NewPendingOver
 }
 
 
-const TArray<FOverlapInfo>* UVRRootComponent::ConvertSweptOverlapsToCurrentOverlaps(
-	TArray<FOverlapInfo>& OverlapsAtEndLocation, const TArray<FOverlapInfo>& SweptOverlaps, int32 SweptOverlapsIndex,
+const TInlineOverlapInfoArray* UVRRootComponent::ConvertSweptOverlapsToCurrentOverlaps(
+	TInlineOverlapInfoArray& OverlapsAtEndLocation, const TArray<FOverlapInfo>& SweptOverlaps, int32 SweptOverlapsIndex,
 	const FVector& EndLocation, const FQuat& EndRotationQuat)
 {
 	checkSlow(SweptOverlapsIndex >= 0);
 
-	const TArray<FOverlapInfo>* Result = nullptr;
+	const TInlineOverlapInfoArray* Result = nullptr;
 	const bool bForceGatherOverlaps = !ShouldCheckOverlapFlagToQueueOverlaps(*this);
 
 	static const auto CVarAllowCachedOverlaps = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AllowCachedOverlaps"));
@@ -1195,7 +1451,11 @@ const TArray<FOverlapInfo>* UVRRootComponent::ConvertSweptOverlapsToCurrentOverl
 				if (SweptOverlaps.Num() == 0 && AreAllCollideableDescendantsRelative())
 				{
 					// Add overlaps with components in this actor.
-					GetOverlapsWithActor(Actor, OverlapsAtEndLocation);
+					for (const FOverlapInfo & Overlap : GetOverlapInfos())
+					{
+						if (FPredicateOverlapHasSameActor(*Actor)(Overlap))
+							OverlapsAtEndLocation.Add(Overlap);
+					}
 					Result = &OverlapsAtEndLocation;
 				}
 			}
@@ -1206,9 +1466,9 @@ const TArray<FOverlapInfo>* UVRRootComponent::ConvertSweptOverlapsToCurrentOverl
 }
 
 
-const TArray<FOverlapInfo>* UVRRootComponent::ConvertRotationOverlapsToCurrentOverlaps(TArray<FOverlapInfo>& OverlapsAtEndLocation, const TArray<FOverlapInfo>& CurrentOverlaps)
+const TInlineOverlapInfoArray* UVRRootComponent::ConvertRotationOverlapsToCurrentOverlaps(TInlineOverlapInfoArray& OverlapsAtEndLocation, const TArray<FOverlapInfo>& CurrentOverlaps)
 {
-	const TArray<FOverlapInfo>* Result = nullptr;
+	const TInlineOverlapInfoArray* Result = nullptr;
 	const bool bForceGatherOverlaps = !ShouldCheckOverlapFlagToQueueOverlaps(*this);
 
 	static const auto CVarAllowCachedOverlaps = IConsoleManager::Get().FindConsoleVariable(TEXT("p.AllowCachedOverlaps"));
@@ -1221,7 +1481,12 @@ const TArray<FOverlapInfo>* UVRRootComponent::ConvertRotationOverlapsToCurrentOv
 			if (bEnableFastOverlapCheck)
 			{
 				// Add all current overlaps that are not children. Children test for their own overlaps after we update our own, and we ignore children in our own update.
-				OverlapsAtEndLocation = CurrentOverlaps.FilterByPredicate(FPredicateOverlapHasDifferentActor(*Actor));
+				FPredicateOverlapHasDifferentActor HasDifferentActor(*Actor);
+				for (const FOverlapInfo & Overlap : CurrentOverlaps)
+				{
+					if (HasDifferentActor(Overlap))
+						OverlapsAtEndLocation.Add(Overlap);
+				}
 				Result = &OverlapsAtEndLocation;
 			}
 		}
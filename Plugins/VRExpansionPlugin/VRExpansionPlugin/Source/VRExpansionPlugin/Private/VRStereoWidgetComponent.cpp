@@ -39,15 +39,20 @@ namespace StereoWidgetCvars
 		ECVF_Default);
 }
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Redraws"), STAT_VRStereoWidgetRedraws, STATGROUP_VRStereoWidget);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Redraws Skipped"), STAT_VRStereoWidgetRedrawsSkipped, STATGROUP_VRStereoWidget);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stereo Widget Layer Texture Updates"), STAT_VRStereoWidgetLayerTextureUpdates, STATGROUP_VRStereoWidget);
+
   //=============================================================================
 UVRStereoWidgetComponent::UVRStereoWidgetComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
-//	, bLiveTexture(false)
+//	, bLiveTexture(true)
 	, bSupportsDepth(false)
 	, bNoAlphaChannel(false)
 	//, Texture(nullptr)
 	//, LeftTexture(nullptr)
 	, bQuadPreserveTextureRatio(false)
+	, bLiveTexture(true)
 	//, StereoLayerQuadSize(FVector2D(500.0f, 500.0f))
 	, UVRect(FBox2D(FVector2D(0.0f, 0.0f), FVector2D(1.0f, 1.0f)))
 	//, CylinderRadius(100)
@@ -58,6 +63,11 @@ UVRStereoWidgetComponent::UVRStereoWidgetComponent(const FObjectInitializer& Obj
 	, Priority(0)
 	, bIsDirty(true)
 	, bTextureNeedsUpdate(false)
+	, bWidgetContentDirty(true)
+	, LastRenderTargetSize(FIntPoint::ZeroValue)
+	, LastRenderTarget(nullptr)
+	, LastRedrawTime(0.0f)
+	, bLastLiveTexture(false)
 	, LayerId(0)
 	, LastTransform(FTransform::Identity)
 	, bLastVisible(false)
@@ -65,6 +75,11 @@ UVRStereoWidgetComponent::UVRStereoWidgetComponent(const FObjectInitializer& Obj
 	bShouldCreateProxy = true;
 	bLastWidgetDrew = false;
 	bUseEpicsWorldLockedStereo = false;
+	bRedrawOnlyWhenDirty = false;
+	MaxCleanRedrawInterval = 0.0f;
+	WidgetRedrawCount = 0;
+	WidgetRedrawsSkippedCount = 0;
+	LayerTextureUpdateCount = 0;
 	// Replace quad size with DrawSize instead
 	//StereoLayerQuadSize = DrawSize;
 
@@ -106,10 +121,26 @@ void UVRStereoWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 {
 
 	// Precaching what the widget uses for draw time here as it gets modified in the super tick
-	bool bWidgetDrew = ShouldDrawWidget();
+	// bWidgetDrew is if the widget is drawable at all (controls the layer), bWidgetRedrew is if the render target gets new content this frame
+	bool bWidgetDrew = Super::ShouldDrawWidget();
+	bool bWidgetRedrew = ShouldDrawWidget();
 
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (bWidgetRedrew)
+	{
+		WidgetRedrawCount++;
+		INC_DWORD_STAT(STAT_VRStereoWidgetRedraws);
+		bWidgetContentDirty = false;
+		LastRedrawTime = GetWorld() ? GetWorld()->GetRealTimeSeconds() : 0.0f;
+		bTextureNeedsUpdate = true;
+	}
+	else if (bWidgetDrew)
+	{
+		WidgetRedrawsSkippedCount++;
+		INC_DWORD_STAT(STAT_VRStereoWidgetRedrawsSkipped);
+	}
+
 	if (StereoWidgetCvars::ForceNoStereoWithVRWidgets)
 	{
 		if (!bShouldCreateProxy)
@@ -251,7 +282,7 @@ void UVRStereoWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	}
 
 	// If the transform changed dirty the layer and push the new transform
-	if (!bIsDirty && (bLastVisible != bVisible || bWidgetDrew != bLastWidgetDrew || FMemory::Memcmp(&LastTransform, &Transform, sizeof(Transform)) != 0))
+	if (!bIsDirty && (bLastVisible != bVisible || bWidgetDrew != bLastWidgetDrew || bLastLiveTexture != (bool)bLiveTexture || FMemory::Memcmp(&LastTransform, &Transform, sizeof(Transform)) != 0))
 	{
 		bIsDirty = true;
 	}
@@ -312,7 +343,8 @@ void UVRStereoWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 			// This needs to be auto set from variables, need to work on it
 			LayerDsec.CylinderHeight = GetDrawSize().Y;//CylinderHeight;
 
-			LayerDsec.Flags |= IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE;// (/*bLiveTexture*/true) ? IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE : 0;
+			// Without continuous updates the texture is only pushed when the widget redraws (see bTextureNeedsUpdate)
+			LayerDsec.Flags |= (bLiveTexture) ? IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE : 0;
 			LayerDsec.Flags |= (bNoAlphaChannel) ? IStereoLayers::LAYER_FLAG_TEX_NO_ALPHA_CHANNEL : 0;
 			LayerDsec.Flags |= (bQuadPreserveTextureRatio) ? IStereoLayers::LAYER_FLAG_QUAD_PRESERVE_TEX_RATIO : 0;
 			LayerDsec.Flags |= (bSupportsDepth) ? IStereoLayers::LAYER_FLAG_SUPPORT_DEPTH : 0;
@@ -389,14 +421,24 @@ void UVRStereoWidgetComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 			{
 				LayerId = StereoLayers->CreateLayer(LayerDsec);
 			}
+
+			// New desc, make sure the current content goes with it
+			bTextureNeedsUpdate = true;
 		}
 		LastTransform = Transform;
 		bLastVisible = bCurrVisible;
+		bLastLiveTexture = bLiveTexture;
 		bIsDirty = false;
 	}
 
 	if (bTextureNeedsUpdate && LayerId)
 	{
+		if (!bLiveTexture)
+		{
+			LayerTextureUpdateCount++;
+			INC_DWORD_STAT(STAT_VRStereoWidgetLayerTextureUpdates);
+		}
+
 		StereoLayers->MarkTextureForUpdate(LayerId);
 		bTextureNeedsUpdate = false;
 	}
@@ -418,6 +460,49 @@ void UVRStereoWidgetComponent::SetPriority(int32 InPriority)
 void UVRStereoWidgetComponent::UpdateRenderTarget(FIntPoint DesiredRenderTargetSize)
 {
 	Super::UpdateRenderTarget(DesiredRenderTargetSize);
+
+	// A resized (or new) render target has no content yet, and the layer has to point at the new texture
+	if (DesiredRenderTargetSize != LastRenderTargetSize || GetRenderTarget() != LastRenderTarget)
+	{
+		LastRenderTargetSize = DesiredRenderTargetSize;
+		LastRenderTarget = GetRenderTarget();
+		bWidgetContentDirty = true;
+		bIsDirty = true;
+	}
+}
+
+void UVRStereoWidgetComponent::MarkTextureForUpdate()
+{
+	bTextureNeedsUpdate = true;
+}
+
+bool UVRStereoWidgetComponent::ShouldDrawWidget() const
+{
+	if (!Super::ShouldDrawWidget())
+		return false;
+
+	if (!bRedrawOnlyWhenDirty || bWidgetContentDirty)
+		return true;
+
+	return MaxCleanRedrawInterval > 0.0f && GetWorld() && (GetWorld()->GetRealTimeSeconds() - LastRedrawTime) >= MaxCleanRedrawInterval;
+}
+
+void UVRStereoWidgetComponent::SetWidget(UUserWidget* InWidget)
+{
+	Super::SetWidget(InWidget);
+	bWidgetContentDirty = true;
+}
+
+void UVRStereoWidgetComponent::MarkWidgetDirty()
+{
+	bWidgetContentDirty = true;
+}
+
+void UVRStereoWidgetComponent::ResetRedrawCounters()
+{
+	WidgetRedrawCount = 0;
+	WidgetRedrawsSkippedCount = 0;
+	LayerTextureUpdateCount = 0;
 }
 
 /** Represents a billboard sprite to the scene manager. */
@@ -729,6 +814,7 @@ FPrimitiveSceneProxy* UVRStereoWidgetComponent::CreateSceneProxy()
 		}
 
 		RequestRedraw();
+		bWidgetContentDirty = true;
 		LastWidgetRenderTime = 0;
 
 		return new FStereoWidget3DSceneProxy(this, *WidgetRenderer->GetSlateRenderer());
@@ -101,6 +101,12 @@ public:
 	
 	FVector LastLocationForLateUpdate;
 
+	// If true the tracked pose is run through the shared tracked pose filter (settings in the VRGlobalSettings)
+	// Jitter inside of the filter deadband doesn't move the controller or trigger a send.
+	// Disables the late update as it would re-apply the raw pose on the render thread.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GripMotionController")
+	bool bUseSharedPoseFilter;
+
 	// If true will offset the tracked location of the controller by the controller profile that is currently loaded.
 	// Thows the event OnControllerProfileTransformChanged when it happens so that you can adjust specific components
 	// Like procedural ones for the offset (procedural meshes are already correctly offset for the controller and
@@ -419,6 +425,17 @@ public:
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
 	float ControllerNetUpdateCount;
 
+	// Scales the send rate with controller motion (ControllerNetUpdateRate is the max) and only sends when past the error thresholds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GripMotionController|Networking")
+	FBPVRAdaptiveNetUpdate AdaptiveNetUpdate;
+
+	// Average transform sends per second over the last second
+	UFUNCTION(BlueprintPure, Category = "GripMotionController|Networking")
+	float GetAverageNetSendRate() const
+	{
+		return AdaptiveNetUpdate.AverageSendRate;
+	}
+
 	// Whether to smooth (lerp) between ticks for the replicated motion, DOES NOTHING if update rate is larger than FPS!
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "GripMotionController|Networking")
 		bool bSmoothReplicatedMotion;
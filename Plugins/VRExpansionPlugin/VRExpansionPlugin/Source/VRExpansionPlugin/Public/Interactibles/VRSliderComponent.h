@@ -21,6 +21,47 @@ enum class EVRInteractibleSliderLerpType : uint8
 	Lerp_InterpConstantTo
 };
 
+// Baked arc length samples of a spline in its local space, used to speed up closest key lookups
+// Samples are grouped into fixed size chunks with bounds so that far away chunks can be skipped
+struct VREXPANSIONPLUGIN_API FVRSliderSplineLookup
+{
+	TArray<FVector> Positions;
+	TArray<float> Keys;
+	TArray<FBox> ChunkBounds;
+
+	// State of the spline when this was baked, if it differs the table gets rebuilt
+	int32 NumSplinePoints;
+	float SplineLength;
+	bool bClosedLoop;
+
+	// Last sample that was closest, used to warm start the next search
+	int32 LastClosestSample;
+
+	static const int32 SamplesPerChunk = 16;
+	static const int32 MaxSamples = 8192;
+
+	FVRSliderSplineLookup()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		Positions.Reset();
+		Keys.Reset();
+		ChunkBounds.Reset();
+		NumSplinePoints = 0;
+		SplineLength = 0.0f;
+		bClosedLoop = false;
+		LastClosestSample = INDEX_NONE;
+	}
+
+	bool IsValid() const
+	{
+		return Positions.Num() > 1;
+	}
+};
+
 /** Delegate for notification when the slider state changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRSliderHitPointSignature, float, SliderProgressPoint);
 
@@ -78,6 +119,20 @@ class VREXPANSIONPLUGIN_API UVRSliderComponent : public UStaticMeshComponent, pu
 	float LastInputKey;
 	float LerpedKey;
 
+	// Distance along the spline between baked samples used for closest key lookups, lower is more accurate but uses more memory
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = "VRSliderComponent", meta = (ClampMin = "0.1", UIMin = "0.1"))
+		float SplineLookupSampleDistance;
+
+	// Rebakes the closest key lookup for the followed spline, call this if the spline is edited at runtime
+	// (it is also rebuilt automatically if the spline point count, length, or looping changes)
+	UFUNCTION(BlueprintCallable, Category = "VRSliderComponent")
+		void RebuildSplineLookup();
+
+	// Returns the input key on the followed spline closest to the world location, uses the baked lookup
+	float FindSplineInputKeyClosestToWorldLocation(const FVector & WorldLocation);
+
+	FVRSliderSplineLookup SplineLookup;
+
 	// Type of lerp to use when following a spline
 	// For lerping I would suggest using ConstantTo in general as it will be the smoothest.
 	// Normal Interp will change speed based on distance, that may also have its uses.
@@ -181,6 +236,7 @@ class VREXPANSIONPLUGIN_API UVRSliderComponent : public UStaticMeshComponent, pu
 	void SetSplineComponentToFollow(USplineComponent * SplineToFollow)
 	{
 		SplineComponentToFollow = SplineToFollow;
+		RebuildSplineLookup();
 		ResetInitialSliderLocation();
 	}
 
@@ -209,7 +265,7 @@ class VREXPANSIONPLUGIN_API UVRSliderComponent : public UStaticMeshComponent, pu
 			float ClosestKey = CurKey;
 			
 			if (!bUseKeyInstead)
-				ClosestKey = SplineComponentToFollow->FindInputKeyClosestToWorldLocation(CurLocation);
+				ClosestKey = FindSplineInputKeyClosestToWorldLocation(CurLocation);
 
 			int32 primaryKey = FMath::TruncToInt(ClosestKey);
 
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_STATS_GROUP(TEXT("VRCharacterRepulsion"), STATGROUP_VRCharacterRepulsion, STATCAT_Advanced);
+
+class UWorld;
+class UVRCharacterMovementComponent;
+
+/**
+* Per world batch for character vs character repulsion.
+* Registered movement components have their capsules gathered once per frame and binned into a uniform grid,
+* the pairwise pushes are then calculated in a single pass over flat arrays.
+* Simulated proxies are members too so they push the characters that are simulated locally, but nothing reads their own results.
+* Simulating physics bodies are still handled by each components own overlap based repulsion.
+* Game thread only.
+*/
+class VREXPANSIONPLUGIN_API FVRCharacterRepulsionManager
+{
+public:
+
+	FVRCharacterRepulsionManager() :
+		LastUpdateFrame(0)
+	{}
+
+	static FVRCharacterRepulsionManager & Get(UWorld * World);
+
+	// Removes the component from its worlds manager, cleans up the manager if it was the last one
+	static void Unregister(UVRCharacterMovementComponent * MoveComp);
+
+	void Register(UVRCharacterMovementComponent * MoveComp);
+
+	// Returns the push velocity (per second) for this component, the grid pass runs on the first call of each frame
+	FVector GetRepulsionVelocity(UVRCharacterMovementComponent * MoveComp);
+
+private:
+
+	friend class FVRCharacterRepulsionGridTest;
+
+	void UpdateRepulsion();
+
+	// Bins the gathered members into the grid and accumulates the pair pushes into Results
+	void CalculatePushes(float MaxRadius);
+
+	TArray<UVRCharacterMovementComponent*> Members;
+
+	// Flat per member data for the pair pass
+	TArray<float> PosX;
+	TArray<float> PosY;
+	TArray<float> MinZ;
+	TArray<float> MaxZ;
+	TArray<float> Radius;
+	TArray<float> Strength;
+	TArray<FVector> Results;
+
+	TMap<FIntPoint, TArray<int32>> Grid;
+	uint64 LastUpdateFrame;
+
+	static TMap<UWorld*, FVRCharacterRepulsionManager> WorldManagers;
+};
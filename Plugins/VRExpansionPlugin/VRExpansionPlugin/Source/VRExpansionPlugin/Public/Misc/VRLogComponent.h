@@ -33,11 +33,27 @@ struct FVRLogMessage
 	FName Category;
 	FName Style;
 
+	// Text to draw, built the first time the line is drawn and then reused
+	FText CachedText;
+	bool bHasCachedText;
+
+	const FText & GetDisplayText()
+	{
+		if (!bHasCachedText)
+		{
+			CachedText = FText::AsCultureInvariant(*Message);
+			bHasCachedText = true;
+		}
+
+		return CachedText;
+	}
+
 	FVRLogMessage(const TSharedRef<FString>& NewMessage, FName NewCategory, FName NewStyle = NAME_None)
 		: Message(NewMessage)
 		, Verbosity(ELogVerbosity::Log)
 		, Category(NewCategory)
 		, Style(NewStyle)
+		, bHasCachedText(false)
 	{
 	}
 
@@ -46,6 +62,7 @@ struct FVRLogMessage
 		, Verbosity(NewVerbosity)
 		, Category(NewCategory)
 		, Style(NewStyle)
+		, bHasCachedText(false)
 	{
 	}
 };
@@ -60,11 +77,17 @@ public:
 	bool bIsDirty;
 	int32 MaxLineLength;
 
+	// Total lines ever added, lets the drawer tell if anything new came in since it last drew
+	uint64 TotalMessagesAdded;
+
 	FVROutputLogHistory()
 	{
 		MaxLineLength = 130;
 		bIsDirty = false;
 		MaxStoredMessages = 1000;
+		FirstMessageIndex = 0;
+		NumMessages = 0;
+		TotalMessagesAdded = 0;
 		GLog->AddOutputDevice(this);
 		GLog->SerializeBacklog(this);
 	}
@@ -78,10 +101,40 @@ public:
 		}
 	}
 
-	/** Gets all captured messages */
-	const TArray< TSharedPtr<FVRLogMessage> >& GetMessages() const
+	/** Number of stored messages */
+	int32 Num() const
+	{
+		return NumMessages;
+	}
+
+	/** Gets a stored message, 0 is the oldest */
+	const TSharedPtr<FVRLogMessage>& GetMessage(int32 Index) const
 	{
-		return Messages;
+		check(Index >= 0 && Index < NumMessages);
+		return Messages[(FirstMessageIndex + Index) % Messages.Num()];
+	}
+
+	/** Changes the amount of stored messages, keeps the newest ones */
+	void SetMaxStoredMessages(int32 NewMaxStoredMessages)
+	{
+		NewMaxStoredMessages = FMath::Max(NewMaxStoredMessages, 1);
+		if (NewMaxStoredMessages == MaxStoredMessages)
+			return;
+
+		TArray< TSharedPtr<FVRLogMessage> > NewMessages;
+		const int32 NumToKeep = FMath::Min(NumMessages, NewMaxStoredMessages);
+		NewMessages.Reserve(NumToKeep);
+
+		for (int i = NumMessages - NumToKeep; i < NumMessages; i++)
+		{
+			NewMessages.Add(GetMessage(i));
+		}
+
+		Messages = MoveTemp(NewMessages);
+		FirstMessageIndex = 0;
+		NumMessages = NumToKeep;
+		MaxStoredMessages = NewMaxStoredMessages;
+		bIsDirty = true;
 	}
 
 protected:
@@ -89,10 +142,34 @@ protected:
 	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category) override
 	{
 		// Capture all incoming messages and store them in history
-		CreateLogMessages(V, Verbosity, Category, Messages);
+		CreateLogMessages(V, Verbosity, Category);
 	}
 
-	bool CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category, TArray< TSharedPtr<FVRLogMessage> >& OutMessages)
+	// Adds into the ring buffer, overwriting the oldest message once it is full
+	void AddMessage(TSharedPtr<FVRLogMessage> && NewMessage)
+	{
+		TotalMessagesAdded++;
+
+		if (NumMessages < MaxStoredMessages)
+		{
+			if (Messages.Num() < MaxStoredMessages)
+			{
+				Messages.Add(MoveTemp(NewMessage));
+			}
+			else
+			{
+				Messages[(FirstMessageIndex + NumMessages) % Messages.Num()] = MoveTemp(NewMessage);
+			}
+			NumMessages++;
+		}
+		else
+		{
+			Messages[FirstMessageIndex] = MoveTemp(NewMessage);
+			FirstMessageIndex = (FirstMessageIndex + 1) % Messages.Num();
+		}
+	}
+
+	bool CreateLogMessages(const TCHAR* V, ELogVerbosity::Type Verbosity, const class FName& Category)
 	{
 		if (Verbosity == ELogVerbosity::SetColor)
 		{
@@ -128,7 +205,7 @@ protected:
 			LogTimestampMode = GetDefault<UEditorStyleSettings>()->LogTimestampMode;
 			}*/
 
-			const int32 OldNumMessages = OutMessages.Num();
+			const uint64 OldTotalMessages = TotalMessagesAdded;
 
 			// handle multiline strings by breaking them apart by line
 			TArray<FTextRange> LineRanges;
@@ -155,14 +232,14 @@ protected:
 							HardWrapLineLen = FMath::Min(HardWrapLen - MessagePrefix.Len(), Line.Len() - CurrentStartIndex);
 							FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
 
-							OutMessages.Add(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MessagePrefix + HardWrapLine)), Verbosity, Category, Style)));
+							AddMessage(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MessagePrefix + HardWrapLine)), Verbosity, Category, Style)));
 						}
 						else
 						{
 							HardWrapLineLen = FMath::Min(HardWrapLen, Line.Len() - CurrentStartIndex);
 							FString HardWrapLine = Line.Mid(CurrentStartIndex, HardWrapLineLen);
 
-							OutMessages.Add(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MoveTemp(HardWrapLine))), Verbosity, Category, Style)));
+							AddMessage(MakeShareable(new FVRLogMessage(MakeShareable(new FString(MoveTemp(HardWrapLine))), Verbosity, Category, Style)));
 						}
 
 						bIsFirstLineInMessage = false;
@@ -171,22 +248,19 @@ protected:
 				}
 			}
 
-			int numMessages = OutMessages.Num();
-			if (numMessages > MaxStoredMessages)
-			{
-				OutMessages.RemoveAt(0, numMessages - MaxStoredMessages, true);
-			}
-			if (OldNumMessages != numMessages)
+			if (OldTotalMessages != TotalMessagesAdded)
 				bIsDirty = true;
 
-			return OldNumMessages != numMessages;//OutMessages.Num();
+			return OldTotalMessages != TotalMessagesAdded;
 		}
 	}
 
 private:
 
-	/** All log messages since this module has been started */
+	/** Ring buffer of the most recent log messages, FirstMessageIndex is the oldest */
 	TArray< TSharedPtr<FVRLogMessage> > Messages;
+	int32 FirstMessageIndex;
+	int32 NumMessages;
 };
 
 /**
@@ -205,7 +279,7 @@ class VREXPANSIONPLUGIN_API UVRLogComponent : public UActorComponent
 	virtual void PostInitProperties() override
 	{
 		Super::PostInitProperties();
-		OutputLogHistory.MaxStoredMessages = FMath::Clamp(MaxStoredMessages, 100, 100000);
+		OutputLogHistory.SetMaxStoredMessages(FMath::Clamp(MaxStoredMessages, 100, 100000));
 		OutputLogHistory.MaxLineLength = FMath::Clamp(MaxLineLength, 50, 1000);
 	}
 
@@ -215,6 +289,10 @@ class VREXPANSIONPLUGIN_API UVRLogComponent : public UActorComponent
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRLogComponent|Console")
 		int32 MaxStoredMessages;
 
+	// Minimum time between output log redraws, new lines that come in sooner wait for the next allowed draw (0 = no limit)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRLogComponent|Console", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float MinOutputLogRedrawInterval;
+
 	// Sets the console input text, can be used to clear the console or enter full or partial commands
 	UFUNCTION(BlueprintCallable, Category = "VRLogComponent|Console", meta = (bIgnoreSelf = "true"))
 		void SetConsoleText(FString Text);
@@ -235,4 +313,11 @@ class VREXPANSIONPLUGIN_API UVRLogComponent : public UActorComponent
 	void DrawConsole(bool bLowerHalfOnly, UCanvas* Canvas);
 	void DrawOutputLog(bool bUpperHalfOnly, UCanvas* Canvas, float ScrollOffset);
 
+private:
+
+	// State of the last output log draw, used to skip redraws when nothing visible changed
+	TWeakObjectPtr<UTextureRenderTarget2D> LastOutputLogTexture;
+	int32 LastOutputLogScrollPos;
+	float LastOutputLogDrawTime;
+
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VRBPDatatypes.h"
+
+DECLARE_STATS_GROUP(TEXT("VRPoseFilter"), STATGROUP_VRPoseFilter, STATCAT_Advanced);
+
+/**
+* Shared pose filtering stage for tracked devices.
+* Each device is filtered at most once per frame, every component that asks for the same device that frame gets the cached result.
+* Filter settings per device type are stored in the VRGlobalSettings.
+* Game thread only.
+*/
+class VREXPANSIONPLUGIN_API FVRPoseFilterStage
+{
+public:
+
+	// Gets the filtered HMD pose for this frame, returns false if the HMD isn't tracking
+	// bOutMoved is false if the filtered pose is being held inside of the deadband
+	static bool GetFilteredHMDPose(FQuat & OutOrientation, FVector & OutPosition, bool & bOutMoved);
+
+	// Filters a raw controller pose, keyed by player index and motion source
+	// bOutMoved is false if the filtered pose is being held inside of the deadband
+	static void FilterControllerPose(int32 PlayerIndex, FName MotionSource, FVector & InOutPosition, FRotator & InOutOrientation, bool & bOutMoved);
+
+	// Clears all device filter states, next poses are passed through unfiltered
+	static void ResetFilters();
+
+	// Clears the filter state of a single controller, used when it grips or drops something so the pose doesn't lag behind the snap
+	static void ResetControllerFilter(int32 PlayerIndex, FName MotionSource);
+};
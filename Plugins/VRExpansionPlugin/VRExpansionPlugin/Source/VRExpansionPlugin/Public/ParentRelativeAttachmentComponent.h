@@ -10,6 +10,9 @@
 #include "VRTrackedParentInterface.h"
 #include "ParentRelativeAttachmentComponent.generated.h"
 
+class AVRCharacter;
+class UCameraComponent;
+
 /**
 * A component that will track the HMD/Cameras location and YAW rotation to allow for chest/waist attachements.
 * This is intended to be parented to the root component of a pawn, it will then either find and track the camera
@@ -35,6 +38,38 @@ class VREXPANSIONPLUGIN_API UParentRelativeAttachmentComponent : public USceneCo
 	float LerpTarget;
 	bool bWasSetOnce;
 
+	// If above 0, the yaw recompute is skipped while the source yaw has changed less than this (in degrees) since the last one
+	// and the last calculated rotation is kept instead, the location is still updated every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary", meta = (ClampMin = "0", UIMin = "0"))
+		float YawUpdateThreshold;
+
+	float LastSourceYaw;
+	FQuat LastCalculatedRotation;
+	bool bHasCalculatedRotation;
+
+	// Owner lookups resolved on begin play / attachment / registration instead of every tick
+	// Also re-resolved when the owners component count changes (components added or removed at runtime) or the cached camera goes away
+	TWeakObjectPtr<AVRCharacter> CachedVRCharacter;
+	TWeakObjectPtr<UCameraComponent> CachedCamera;
+	int32 CachedOwnerComponentCount;
+	bool bOwnerCacheDirty;
+
+	// Forces the cached owning character and camera to be looked up again
+	UFUNCTION(BlueprintCallable, Category = "VRExpansionLibrary")
+	void InvalidateOwnerCache()
+	{
+		bOwnerCacheDirty = true;
+	}
+
+	void RefreshOwnerCache();
+
+	// True if the owner has changed in a way that the cached lookups need to be redone
+	bool NeedsOwnerCacheRefresh() const;
+
+	virtual void BeginPlay() override;
+	virtual void OnRegister() override;
+	virtual void OnAttachmentChanged() override;
+
 	// If true uses feet/bottom of the capsule as the base Z position for this component instead of the HMD/Camera Z position
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
 	bool bUseFeetLocation;
@@ -66,6 +101,28 @@ class VREXPANSIONPLUGIN_API UParentRelativeAttachmentComponent : public USceneCo
 		return MyPawn ? MyPawn->IsLocallyControlled() : (MyOwner->Role == ENetRole::ROLE_Authority);
 	}
 
+	// True if the yaw recompute can be skipped this frame and the last calculated rotation used instead
+	inline bool CanSkipYawUpdate(float SourceYaw) const
+	{
+		if (YawUpdateThreshold <= 0.0f || !bHasCalculatedRotation)
+			return false;
+
+		// Still turning towards a lerp target, has to keep updating
+		if (bLerpTransition && !FMath::IsNearlyZero(YawTolerance) && !FMath::IsNearlyEqual(LastLerpVal, LerpTarget))
+			return false;
+
+		return FMath::Abs(FRotator::NormalizeAxis(SourceYaw - LastSourceYaw)) < YawUpdateThreshold;
+	}
+
+	// Sets the location and re-uses the last calculated rotation
+	inline void SetRelativeLocWithLastRot(FVector NewRelativeLocation)
+	{
+		if (bUseFeetLocation)
+			NewRelativeLocation.Z = 0.0f;
+
+		SetRelativeLocationAndRotation(NewRelativeLocation, LastCalculatedRotation);
+	}
+
 	// Sets the rotation and location depending on the control variables. Trying to remove some code duplication here
 	inline void SetRelativeRotAndLoc(FVector NewRelativeLocation, FRotator NewRelativeRotation, float DeltaTime)
 	{
@@ -141,7 +198,9 @@ class VREXPANSIONPLUGIN_API UParentRelativeAttachmentComponent : public USceneCo
 			LastRot = FRotator::ClampAxis(InverseRot.Yaw);
 		}
 
-		return FinalRot.Quaternion();
+		LastCalculatedRotation = FinalRot.Quaternion();
+		bHasCalculatedRotation = true;
+		return LastCalculatedRotation;
 	}
 };
 
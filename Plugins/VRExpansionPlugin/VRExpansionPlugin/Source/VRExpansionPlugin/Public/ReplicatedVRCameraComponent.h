@@ -6,6 +6,8 @@
 #include "Net/UnrealNetwork.h"
 #include "ReplicatedVRCameraComponent.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("ReplicatedVRCamera"), STATGROUP_ReplicatedVRCamera, STATCAT_Advanced);
+
 class AVRBaseCharacter;
 
 /**
@@ -34,6 +36,11 @@ class VREXPANSIONPLUGIN_API UReplicatedVRCameraComponent : public UCameraCompone
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera")
 	bool bOffsetByHMD;
 
+	// If true the pose sent to the server (and set during tick) comes from the shared tracked pose filter (settings in the VRGlobalSettings)
+	// Jitter inside of the filter deadband doesn't trigger a send, the rendered view itself is never filtered
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera")
+	bool bUseSharedPoseFilter;
+
 	/** Sets lock to hmd automatically based on if the camera is currently locally controlled or not */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera")
 		uint32 bAutoSetLockToHmd : 1;
@@ -83,6 +90,17 @@ class VREXPANSIONPLUGIN_API UReplicatedVRCameraComponent : public UCameraCompone
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case.
 	float NetUpdateCount;
 
+	// Scales the send rate with HMD motion (NetUpdateRate is the max) and only sends when past the error thresholds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera|Networking")
+	FBPVRAdaptiveNetUpdate AdaptiveNetUpdate;
+
+	// Average transform sends per second over the last second
+	UFUNCTION(BlueprintPure, Category = "ReplicatedCamera|Networking")
+	float GetAverageNetSendRate() const
+	{
+		return AdaptiveNetUpdate.AverageSendRate;
+	}
+
 	// I'm sending it unreliable because it is being resent pretty often
 	UFUNCTION(Unreliable, Server, WithValidation)
 	void Server_SendCameraTransform(FBPVRComponentPosRep NewTransform);
@@ -24,6 +24,44 @@ class AVRSimpleCharacter;
 //class UVRSimpleRootComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSimpleCharacterMovement, Log, All);
+DECLARE_STATS_GROUP(TEXT("VRSimpleCharacterMovement"), STATGROUP_VRSimpleCharacterMovement, STATCAT_Advanced);
+
+// Last full floor check result, reused by FindFloor while the capsule stays close to where it was taken
+// Only lives for the frame it was taken in (so new floors / obstacles are picked up next frame) and is dropped on any blocking hit
+struct FVRSimpleFloorResultCache
+{
+	FFindFloorResult FloorResult;
+	FVector CapsuleLocation;
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+	TWeakObjectPtr<UPrimitiveComponent> FloorPrimitive;
+	EComponentMobility::Type FloorMobility;
+	FTransform FloorTransform;
+	uint64 FrameNumber;
+	bool bIsValid;
+
+	// Lookups served from the cache and lookups that ran the full floor check, kept across invalidations
+	uint32 NumHits;
+	uint32 NumMisses;
+
+	FVRSimpleFloorResultCache() :
+		CapsuleLocation(FVector::ZeroVector),
+		CapsuleRadius(0.0f),
+		CapsuleHalfHeight(0.0f),
+		FloorMobility(EComponentMobility::Static),
+		FloorTransform(FTransform::Identity),
+		FrameNumber(0),
+		bIsValid(false),
+		NumHits(0),
+		NumMisses(0)
+	{}
+
+	void Invalidate()
+	{
+		bIsValid = false;
+		FloorPrimitive.Reset();
+	}
+};
 
 /** Shared pointer for easy memory management of FSavedMove_Character, for accumulating and replaying network moves. */
 //typedef TSharedPtr<class FSavedMove_Character> FSavedMovePtr;
@@ -69,6 +107,21 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = VRMovement)
 		bool bSkipHMDChecks;
 
+	// Reuse the last walkable floor result across sub steps while the capsule moves less than FloorCacheTolerance
+	// horizontally over a flat floor whose transform hasn't changed. The capsule has to be fully inside of the floors bounds
+	// so ledges are never crossed on a cached result, and any blocking hit or new frame drops the cache.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = VRMovement)
+		bool bUseFloorResultCache;
+
+	// Horizontal distance the capsule can move from where the cached floor was found before a new floor check is run
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = VRMovement, meta = (EditCondition = "bUseFloorResultCache", ClampMin = "0.0", UIMin = "0.0"))
+		float FloorCacheTolerance;
+
+	virtual void FindFloor(const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bZeroDelta, const FHitResult* DownwardSweepResult = NULL) const override;
+
+	// Drops the floor result cache on blocking hits
+	virtual bool MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit = NULL, ETeleportType Teleport = ETeleportType::None) override;
+
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
@@ -116,6 +169,13 @@ public:
 	///////////////////////////
 	// End Replication Functions
 	///////////////////////////
+
+protected:
+
+	friend class FVRSimpleFloorCacheEquivalenceTest;
+	friend class FVRSimpleFloorCacheWalkTest;
+
+	mutable FVRSimpleFloorResultCache FloorResultCache;
 };
 
 class VREXPANSIONPLUGIN_API FSavedMove_VRSimpleCharacter : public FSavedMove_VRBaseCharacter
@@ -197,8 +197,8 @@ public:
 	/** Smooth vector */
 	FVector RunFilterSmoothing(const FVector &InRawValue, const float &InDeltaTime)
 	{
-		// Calculate the delta, if this is the first time then there is no delta
-		const FVector Delta = RawFilter.bFirstTime == true ? FVector::ZeroVector : (InRawValue - RawFilter.Previous) * InDeltaTime;
+		// Calculate the rate of change, if this is the first time then there is no delta
+		const FVector Delta = (RawFilter.bFirstTime == true || InDeltaTime <= 0.f) ? FVector::ZeroVector : (InRawValue - RawFilter.Previous) / InDeltaTime;
 
 		// Filter the delta to get the estimated
 		const FVector Estimated = DeltaFilter.Filter(Delta, FVector(CalculateAlpha(DeltaCutoff, InDeltaTime)));
@@ -243,6 +243,294 @@ private:
 
 };
 
+// Settings for the shared tracked device pose filter
+// 1 Euro filtering on the position and rotation, followed by a deadband that holds the last output while the filtered pose is inside of it
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPVRPoseFilterSettings
+{
+	GENERATED_BODY()
+public:
+
+	// Cutoff frequency (hz) used when the device is at rest, lower values remove more jitter but add lag
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.01", UIMin = "0.01"))
+		float MinCutoff;
+
+	// How much the position cutoff rises per cm/s of device speed, higher values reduce lag during fast movements
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float CutoffSlope;
+
+	// How much the rotation cutoff rises per deg/s of device angular speed, higher values reduce lag during fast turns
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float RotationCutoffSlope;
+
+	// Cutoff frequency (hz) used when filtering the device speed
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.01", UIMin = "0.01"))
+		float DeltaCutoff;
+
+	// Distance (in cm) the filtered position has to move from the last output before it is accepted
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float PositionDeadband;
+
+	// Angle (in degrees) the filtered rotation has to turn from the last output before it is accepted
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "FilterSettings", meta = (ClampMin = "0.0", UIMin = "0.0"))
+		float RotationDeadband;
+
+	FBPVRPoseFilterSettings() :
+		MinCutoff(1.0f),
+		CutoffSlope(0.007f),
+		RotationCutoffSlope(0.007f),
+		DeltaCutoff(1.0f),
+		PositionDeadband(0.05f),
+		RotationDeadband(0.1f)
+	{}
+
+	FBPVRPoseFilterSettings(float InMinCutoff, float InCutoffSlope, float InRotationCutoffSlope, float InDeltaCutoff, float InPositionDeadband, float InRotationDeadband) :
+		MinCutoff(InMinCutoff),
+		CutoffSlope(InCutoffSlope),
+		RotationCutoffSlope(InRotationCutoffSlope),
+		DeltaCutoff(InDeltaCutoff),
+		PositionDeadband(InPositionDeadband),
+		RotationDeadband(InRotationDeadband)
+	{}
+};
+
+// 1 Euro filter over a full pose, the position runs through an FBPEuroLowPassFilter
+// The rotation is slerped with its own cutoff driven by the angular speed (deg/s), so it doesn't suffer from euler wrap around
+class VREXPANSIONPLUGIN_API FVRPoseFilter
+{
+public:
+
+	FVRPoseFilter() :
+		OutputPosition(FVector::ZeroVector),
+		OutputOrientation(FQuat::Identity),
+		FilteredOrientation(FQuat::Identity),
+		AngularSpeed(0.0f),
+		bFirstTime(true)
+	{}
+
+	void Reset()
+	{
+		PositionFilter.ResetSmoothingFilter();
+		bFirstTime = true;
+	}
+
+	// Filters the raw pose, returns false if the result stayed inside of the deadband (output is the held pose)
+	bool Filter(const FBPVRPoseFilterSettings & Settings, const FVector & RawPosition, const FQuat & RawOrientation, float DeltaTime, FVector & OutPosition, FQuat & OutOrientation)
+	{
+		if (!bFirstTime && DeltaTime <= KINDA_SMALL_NUMBER)
+		{
+			OutPosition = OutputPosition;
+			OutOrientation = OutputOrientation;
+			return false;
+		}
+
+		PositionFilter.MinCutoff = Settings.MinCutoff;
+		PositionFilter.CutoffSlope = Settings.CutoffSlope;
+		PositionFilter.DeltaCutoff = Settings.DeltaCutoff;
+
+		// The euro filter passes the first sample through unchanged
+		const FVector FilteredPosition = PositionFilter.RunFilterSmoothing(RawPosition, DeltaTime);
+
+		if (bFirstTime)
+		{
+			FilteredOrientation = RawOrientation;
+			AngularSpeed = 0.0f;
+			OutputPosition = FilteredPosition;
+			OutputOrientation = FilteredOrientation;
+			bFirstTime = false;
+			OutPosition = OutputPosition;
+			OutOrientation = OutputOrientation;
+			return true;
+		}
+
+		// Rotation, the speed is the angular difference from the last filtered rotation in deg/s, same as the position delta
+		const float RawAngularSpeed = FMath::RadiansToDegrees(FilteredOrientation.AngularDistance(RawOrientation)) / DeltaTime;
+		AngularSpeed = FMath::Lerp(AngularSpeed, RawAngularSpeed, CalculateAlpha(Settings.DeltaCutoff, DeltaTime));
+		FilteredOrientation = FQuat::Slerp(FilteredOrientation, RawOrientation, CalculateAlpha(Settings.MinCutoff + Settings.RotationCutoffSlope * AngularSpeed, DeltaTime));
+		FilteredOrientation.Normalize();
+
+		bool bChanged = false;
+
+		if (FVector::DistSquared(FilteredPosition, OutputPosition) > FMath::Square(Settings.PositionDeadband))
+		{
+			OutputPosition = FilteredPosition;
+			bChanged = true;
+		}
+
+		if (FMath::RadiansToDegrees(FilteredOrientation.AngularDistance(OutputOrientation)) > Settings.RotationDeadband)
+		{
+			OutputOrientation = FilteredOrientation;
+			bChanged = true;
+		}
+
+		OutPosition = OutputPosition;
+		OutOrientation = OutputOrientation;
+		return bChanged;
+	}
+
+private:
+
+	static float CalculateAlpha(const float InCutoff, const float InDeltaTime)
+	{
+		const float tau = 1.0f / (2.0f * PI * FMath::Max(InCutoff, KINDA_SMALL_NUMBER));
+		return 1.0f / (1.0f + tau / InDeltaTime);
+	}
+
+	FBPEuroLowPassFilter PositionFilter;
+	FVector OutputPosition;
+	FQuat OutputOrientation;
+	FQuat FilteredOrientation;
+	float AngularSpeed;
+	bool bFirstTime;
+};
+
+// Adaptive send rate policy for replicated tracked components
+// Sends scale between MinUpdateRate and the components max rate based on how fast the device is moving,
+// and only go out when the receiver (which holds the last sent pose) would be off by more than the error thresholds.
+// A keep-alive send still goes out at MinUpdateRate when still, as the sends are unreliable.
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPVRAdaptiveNetUpdate
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate")
+		bool bUseAdaptiveNetUpdate;
+
+	// Keep-alive rate (htz) used when the device is still
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdate", ClampMin = "0.1", UIMin = "0.1"))
+		float MinUpdateRate;
+
+	// Linear speed (cm/s) at which the full update rate is used
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdate", ClampMin = "0.01", UIMin = "0.01"))
+		float LinearSpeedForMaxRate;
+
+	// Angular speed (deg/s) at which the full update rate is used
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdate", ClampMin = "0.01", UIMin = "0.01"))
+		float AngularSpeedForMaxRate;
+
+	// Positional error (cm) from the last sent pose before a new send is needed
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdate", ClampMin = "0.0", UIMin = "0.0"))
+		float PositionErrorThreshold;
+
+	// Rotational error (degrees) from the last sent pose before a new send is needed
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdate", ClampMin = "0.0", UIMin = "0.0"))
+		float RotationErrorThreshold;
+
+	// Current target send rate (htz)
+	float CurrentUpdateRate;
+
+	// Average sends per second over the last completed second, tracked whether adaptive sending is on or not
+	float AverageSendRate;
+
+	FBPVRAdaptiveNetUpdate() :
+		bUseAdaptiveNetUpdate(false),
+		MinUpdateRate(5.0f),
+		LinearSpeedForMaxRate(100.0f),
+		AngularSpeedForMaxRate(180.0f),
+		PositionErrorThreshold(0.1f),
+		RotationErrorThreshold(0.5f),
+		CurrentUpdateRate(0.0f),
+		AverageSendRate(0.0f),
+		LastPosition(FVector::ZeroVector),
+		LastRotation(FQuat::Identity),
+		bHasLastPose(false),
+		TimeSinceSend(0.0f),
+		SendRateWindowTime(0.0f),
+		SendRateWindowCount(0)
+	{}
+
+	// Returns true if the current pose should be sent, MaxUpdateRate is the components configured net update rate
+	bool ShouldSend(const FVector & Position, const FRotator & Rotation, const FVector & SentPosition, const FRotator & SentRotation, float MaxUpdateRate, float DeltaTime)
+	{
+		const FQuat RotationQuat = Rotation.Quaternion();
+		TimeSinceSend += DeltaTime;
+
+		float SpeedAlpha = 1.0f;
+		if (bHasLastPose && DeltaTime > KINDA_SMALL_NUMBER)
+		{
+			const float LinearSpeed = FVector::Dist(Position, LastPosition) / DeltaTime;
+			const float AngularSpeed = FMath::RadiansToDegrees(RotationQuat.AngularDistance(LastRotation)) / DeltaTime;
+			SpeedAlpha = FMath::Clamp(FMath::Max(LinearSpeed / LinearSpeedForMaxRate, AngularSpeed / AngularSpeedForMaxRate), 0.0f, 1.0f);
+		}
+
+		LastPosition = Position;
+		LastRotation = RotationQuat;
+		bHasLastPose = true;
+
+		CurrentUpdateRate = FMath::Lerp(FMath::Min(MinUpdateRate, MaxUpdateRate), MaxUpdateRate, SpeedAlpha);
+
+		// Keep-alive
+		if (TimeSinceSend >= 1.0f / MinUpdateRate)
+			return true;
+
+		if (TimeSinceSend < 1.0f / CurrentUpdateRate)
+			return false;
+
+		// Receiver ends up on the last sent pose, only send if it is too far off
+		return FVector::DistSquared(Position, SentPosition) > FMath::Square(PositionErrorThreshold) ||
+			FMath::RadiansToDegrees(RotationQuat.AngularDistance(SentRotation.Quaternion())) > RotationErrorThreshold;
+	}
+
+	// Tracks the average send rate, call once per tick with whether a send went out
+	void UpdateSendRate(bool bSent, float DeltaTime)
+	{
+		if (bSent)
+		{
+			TimeSinceSend = 0.0f;
+			SendRateWindowCount++;
+		}
+
+		SendRateWindowTime += DeltaTime;
+		if (SendRateWindowTime >= 1.0f)
+		{
+			AverageSendRate = SendRateWindowCount / SendRateWindowTime;
+			SendRateWindowTime = 0.0f;
+			SendRateWindowCount = 0;
+		}
+	}
+
+private:
+
+	FVector LastPosition;
+	FQuat LastRotation;
+	bool bHasLastPose;
+	float TimeSinceSend;
+	float SendRateWindowTime;
+	int32 SendRateWindowCount;
+};
+
+// Per component average of the adaptive send rates for the stat counters
+// Every component adds its rate each tick, the result is the average of the components that have ticked so far this frame
+struct FVRAverageSendRateStat
+{
+	FVRAverageSendRateStat() :
+		LastFrame(0),
+		RateSum(0.0f),
+		NumComponents(0)
+	{}
+
+	float Add(float SendRate)
+	{
+		if (LastFrame != GFrameCounter)
+		{
+			LastFrame = GFrameCounter;
+			RateSum = 0.0f;
+			NumComponents = 0;
+		}
+
+		RateSum += SendRate;
+		NumComponents++;
+		return RateSum / NumComponents;
+	}
+
+private:
+
+	uint64 LastFrame;
+	float RateSum;
+	int32 NumComponents;
+};
+
 //USTRUCT(BlueprintType, Category = "VRExpansionLibrary|Transform")
 
 USTRUCT(/*noexport, */BlueprintType, Category = "VRExpansionLibrary|Transform", meta = (HasNativeMake = "VRExpansionPlugin.VRExpansionPluginFunctionLibrary.MakeTransform_NetQuantize", HasNativeBreak = "VRExpansionPlugin.VRExpansionPluginFunctionLibrary.BreakTransform_NetQuantize"))
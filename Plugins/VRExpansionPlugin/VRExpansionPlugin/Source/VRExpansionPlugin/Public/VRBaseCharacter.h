@@ -640,6 +640,9 @@ public:
 	UFUNCTION(Reliable, NetMulticast, Category = "VRGrip")
 		virtual void NotifyOfTeleport();
 
+	// Restarts the shared pose filters on the owning client so the teleport doesn't get smoothed over
+	virtual bool TeleportTo(const FVector& DestLocation, const FRotator& DestRotation, bool bIsATest = false, bool bNoCheck = false) override;
+
 
 	// Event triggered when a move action is performed, this is ran just prior to PerformMovement in the character tick
 	UFUNCTION(BlueprintNativeEvent, Category = "VRMovement")
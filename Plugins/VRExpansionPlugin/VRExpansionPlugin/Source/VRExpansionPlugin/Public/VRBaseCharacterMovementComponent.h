@@ -23,6 +23,14 @@
  * @see https://docs.unrealengine.com/latest/INT/Gameplay/Framework/Pawn/Character/
  */
 
+// Network smoothing tiers for simulated proxies, see bUseNetworkSmoothingLOD
+enum class EVRSmoothingLOD : uint8
+{
+	Full,
+	Reduced,
+	Snap
+};
+
 UENUM(Blueprintable)
 enum class EVRMoveAction : uint8
 {
@@ -495,11 +503,10 @@ public:
 		return Result;
 	}
 
-	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const override
+	// Checks the VR specific data of two moves for combining, when bQuantized is set the VR deltas only need to match
+	// at the precision they are sent at (FVector_NetQuantize100 / compressed yaw) instead of exactly
+	bool CanCombineVRData(const FSavedMove_VRBaseCharacter * nMove, bool bQuantized) const
 	{
-		FSavedMove_VRBaseCharacter * nMove = (FSavedMove_VRBaseCharacter *)NewMove.Get();
-
-
 		if (!nMove || (VRReplicatedMovementMode != nMove->VRReplicatedMovementMode))
 			return false;
 
@@ -512,6 +519,23 @@ public:
 		if (!ConditionalValues.RequestedVelocity.IsZero() || !nMove->ConditionalValues.RequestedVelocity.IsZero())
 			return false;
 
+		if (bQuantized)
+		{
+			// Capsule height is sent in LFDiff.Z, the server can't tell the difference if these round the same
+			if (FMath::RoundToInt(LFDiff.Z * 100.0f) != FMath::RoundToInt(nMove->LFDiff.Z * 100.0f))
+				return false;
+
+			if (FRotator::CompressAxisToShort(VRCapsuleRotation.Yaw) != FRotator::CompressAxisToShort(nMove->VRCapsuleRotation.Yaw))
+				return false;
+
+			// XY deltas are summed when combined, only merge steady HMD movement
+			if (FMath::RoundToInt(LFDiff.X * 100.0f) != FMath::RoundToInt(nMove->LFDiff.X * 100.0f) ||
+				FMath::RoundToInt(LFDiff.Y * 100.0f) != FMath::RoundToInt(nMove->LFDiff.Y * 100.0f))
+				return false;
+
+			return true;
+		}
+
 		// Hate this but we really can't combine if I am sending a new capsule height
 		if (!FMath::IsNearlyEqual(LFDiff.Z, nMove->LFDiff.Z))
 			return false;
@@ -519,6 +543,23 @@ public:
 		if (!LFDiff.IsZero() && !nMove->LFDiff.IsZero() && !FVector::Coincident(LFDiff.GetSafeNormal2D(), nMove->LFDiff.GetSafeNormal2D(), AccelDotThresholdCombine))
 			return false;
 
+		return true;
+	}
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const override
+	{
+		if (!CanCombineVRData((FSavedMove_VRBaseCharacter *)NewMove.Get(), false))
+			return false;
+
+		return FSavedMove_Character::CanCombineWith(NewMove, Character, MaxDelta);
+	}
+
+	// Aggressive version of CanCombineWith, merges moves whose VR deltas are equal once quantized for sending
+	bool CanCombineWithQuantized(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const
+	{
+		if (!CanCombineVRData((FSavedMove_VRBaseCharacter *)NewMove.Get(), true))
+			return false;
+
 		return FSavedMove_Character::CanCombineWith(NewMove, Character, MaxDelta);
 	}
 
@@ -708,6 +749,33 @@ public:
 	virtual void PhysCustom_Climbing(float deltaTime, int32 Iterations);
 	virtual void PhysCustom_LowGrav(float deltaTime, int32 Iterations);
 
+	// If true simulated proxies scale back their network smoothing based on distance to the local view and whether they were rendered recently
+	// Close proxies run the full smoothing mode, mid range proxies run it at SmoothingLODReducedRate, far or occluded proxies snap to the corrected position
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Smoothing")
+	bool bUseNetworkSmoothingLOD;
+
+	// Distance from the local view past which smoothing runs at the reduced rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Smoothing", meta = (EditCondition = "bUseNetworkSmoothingLOD", ClampMin = "0", UIMin = "0"))
+	float SmoothingLODReducedDistance;
+
+	// Distance from the local view past which corrections are snapped instead of smoothed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Smoothing", meta = (EditCondition = "bUseNetworkSmoothingLOD", ClampMin = "0", UIMin = "0"))
+	float SmoothingLODSnapDistance;
+
+	// Updates per second for the reduced smoothing tier
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Smoothing", meta = (EditCondition = "bUseNetworkSmoothingLOD", ClampMin = "1", UIMin = "1"))
+	float SmoothingLODReducedRate;
+
+	// Proxies that have not been rendered within this many seconds are treated as occluded and snapped
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRMovement|Smoothing", meta = (EditCondition = "bUseNetworkSmoothingLOD", ClampMin = "0", UIMin = "0"))
+	float SmoothingLODOcclusionTime;
+
+	// Picks the smoothing tier for this proxy this frame
+	EVRSmoothingLOD GetNetworkSmoothingLOD() const;
+
+	// Time accumulated while waiting for the next reduced rate smoothing update
+	float SmoothingLODAccumulatedTime;
+
 	/**
 	* Smooth mesh location for network interpolation, based on values set up by SmoothCorrection.
 	* Internally this simply calls SmoothClientPosition_Interpolate() then SmoothClientPosition_UpdateVisuals().
@@ -716,6 +784,9 @@ public:
 	*/
 	virtual void SmoothClientPosition(float DeltaSeconds) override;
 
+	// With bUseNetworkSmoothingLOD, proxies in the snap tier take the new position directly instead of setting up smoothing offsets
+	virtual void SmoothCorrection(const FVector& OldLocation, const FQuat& OldRotation, const FVector& NewLocation, const FQuat& NewRotation) override;
+
 	/** Update mesh location based on interpolated values. */
 	void SmoothClientPosition_UpdateVRVisuals();
 
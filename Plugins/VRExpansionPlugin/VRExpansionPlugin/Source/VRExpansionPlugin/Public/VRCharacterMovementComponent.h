@@ -69,6 +69,44 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent")
 	bool bAllowMovementMerging;
 
+	// When merging movement, also merge moves whose VR deltas (LFDiff, capsule height and yaw) are equal at replicated precision
+	// Cuts down on saved moves and ServerMoveVR RPCs while the HMD is steady or moving at a constant rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent", meta = (EditCondition = "bAllowMovementMerging"))
+	bool bAllowQuantizedMovementMerging;
+
+	// Number of saved moves allocated up front for client prediction, they are recycled through the free list after that
+	// so high latency / packet loss doesn't churn the allocator. Moves past this count are still allocated but not kept.
+	// Read when the client prediction data is created, the pool is filled on the first saved move.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent", meta = (ClampMin = "0", UIMin = "0"))
+	int32 SavedMovePoolSize;
+
+	// Server side, when a single dual move RPC carries two compatible moves they are simulated as one step over the combined delta time,
+	// error checking runs on the result. Compatible is same flags and acceleration, no one off inputs on the older move, and the server
+	// already being on the client's movement base and in the client's movement mode. Separate RPCs that arrive together are not merged.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent")
+	bool bEnableServerMoveCoalescing;
+
+	// Returns true if the pending move of a dual move RPC can be folded into the new move on the server
+	bool CanCoalesceServerMoves(float TimeStamp0, const FVector & InAccel0, uint8 PendingFlags, const FVRConditionalMoveRep & OldConditionalReps, float TimeStamp, const FVector & InAccel, uint8 NewFlags, const FVRConditionalMoveRep2 & MoveReps, uint8 ClientMovementMode);
+
+	// If true characters using this also push each other apart, batched per world through a uniform grid (see FVRCharacterRepulsionManager)
+	// Simulated proxies are in the grid as pushers only, so the owning client predicts being pushed by them but they never take a push themselves
+	// Simulating physics bodies are still repulsed through the overlaps as normal
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent")
+	bool bUseCharacterRepulsionGrid;
+
+	// Velocity change per second (cm/s) applied at full overlap with another character
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent", meta = (EditCondition = "bUseCharacterRepulsionGrid", ClampMin = "0", UIMin = "0"))
+	float CharacterRepulsionStrength;
+
+	// Index into the repulsion managers member list, INDEX_NONE when not registered
+	int32 RepulsionGridIndex;
+
+	// Simulated proxies don't perform moves, so they are kept in the repulsion grid from tick instead of ApplyRepulsionForce
+	void UpdateSimulatedProxyRepulsion();
+
+	virtual void OnUnregister() override;
+
 	// Higher values will cause more slide but better step up
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRCharacterMovementComponent", meta = (ClampMin = "0.01", UIMin = "0", ClampMax = "1.0", UIMax = "1"))
 	float WallRepulsionMultiplier;
@@ -351,16 +389,15 @@ public:
 class VREXPANSIONPLUGIN_API FNetworkPredictionData_Client_VRCharacter : public FNetworkPredictionData_Client_Character
 {
 public:
-	FNetworkPredictionData_Client_VRCharacter(const UCharacterMovementComponent& ClientMovement)
-		: FNetworkPredictionData_Client_Character(ClientMovement)
-	{
+	FNetworkPredictionData_Client_VRCharacter(const UCharacterMovementComponent& ClientMovement);
 
-	}
+	virtual FSavedMovePtr AllocateNewMove() override;
 
-	FSavedMovePtr AllocateNewMove()
-	{
-		return FSavedMovePtr(new FSavedMove_VRCharacter());
-	}
+	// Fills the free list on first use, AllocateNewMove is virtual so it can't be called from the constructor
+	virtual FSavedMovePtr CreateSavedMove() override;
+
+private:
+	bool bFilledFreeMoves;
 };
 
 
@@ -137,6 +137,7 @@ public:
 	* Finds the minimum area rectangle that encloses all of the points in InVerts
 	* Engine default version is server only for some reason
 	* Uses algorithm found in http://www.geometrictools.com/Documentation/MinimumAreaRectangle.pdf
+	* Convex hull is a monotone chain and the rectangle is found with rotating calipers, O(n log n) so it is fine with large scan point sets
 	*
 	* @param		InVerts	- Points to enclose in the rectangle
 	* @outparam	OutRectCenter - Center of the enclosing rectangle
@@ -166,6 +167,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "VRGrip", meta = (bIgnoreSelf = "true", DisplayName = "GetGripSlotInRangeByTypeName_Component"))
 	static void GetGripSlotInRangeByTypeName_Component(FName SlotType, UPrimitiveComponent * Component, FVector WorldLocation, float MaxRange, bool & bHadSlotInRange, FTransform & SlotWorldTransform);
 
+	// Finds the closest grip slot of the given type within range on the component
+	// Static and skeletal mesh components use a slot table cached per mesh asset, other components fall back to searching their socket names
+	static bool GetClosestGripSlotInRange(FName SlotType, USceneComponent * Component, FVector WorldLocation, float MaxRange, FTransform & SlotWorldTransform);
+
+	// Clears the cached grip slot tables, only needed if mesh sockets are changed at runtime
+	UFUNCTION(BlueprintCallable, Category = "VRGrip", meta = (bIgnoreSelf = "true", DisplayName = "ClearGripSlotCache"))
+	static void ClearGripSlotCache();
+
 	/* Returns true if the values are equal (A == B) */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Equal VR Grip", CompactNodeTitle = "==", Keywords = "== equal"), Category = "VRExpansionFunctions")
 	static bool EqualEqual_FBPActorGripInformation(const FBPActorGripInformation &A, const FBPActorGripInformation &B);
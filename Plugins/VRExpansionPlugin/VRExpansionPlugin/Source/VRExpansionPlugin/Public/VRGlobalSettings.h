@@ -132,6 +132,14 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Secondary Grip 1Euro Settings")
 	float OneEuroDeltaCutoff;
 
+	// Filter settings for the HMD when components use the shared tracked pose filter
+	UPROPERTY(config, EditAnywhere, Category = "Tracked Pose Filter Settings")
+	FBPVRPoseFilterSettings HMDPoseFilterSettings;
+
+	// Filter settings for motion controllers when components use the shared tracked pose filter
+	UPROPERTY(config, EditAnywhere, Category = "Tracked Pose Filter Settings")
+	FBPVRPoseFilterSettings ControllerPoseFilterSettings;
+
 	// Adjust the transform of a socket for a particular controller model, if a name is not sent in, it will use the currently loaded one
 	// If there is no currently loaded one, it will return the input transform as is.
 	// If bIsRightHand and the target profile uses seperate hand transforms it will use the right hand transform
@@ -19,6 +19,24 @@ DECLARE_STATS_GROUP(TEXT("VRRootComponent"), STATGROUP_VRRootComponent, STATCAT_
 DECLARE_CYCLE_STAT(TEXT("VR Root Set Half Height"), STAT_VRRootSetHalfHeight, STATGROUP_VRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("VR Root Set Capsule Size"), STAT_VRRootSetCapsuleSize, STATGROUP_VRRootComponent);
 
+typedef TArray<FOverlapInfo, TInlineAllocator<3>> TInlineOverlapInfoArray;
+
+class UVRRootComponent;
+
+/**
+* Defers overlap updates on a VRRootComponent until the outermost scope ends, all moves inside of it
+* (including ones in nested FScopedMovementUpdates) are coalesced into a single UpdateOverlaps call.
+*/
+class VREXPANSIONPLUGIN_API FVRRootScopedOverlapDeferral : private FNoncopyable
+{
+public:
+	FVRRootScopedOverlapDeferral(UVRRootComponent * InRoot, bool bEnabled = true);
+	~FVRRootScopedOverlapDeferral();
+
+private:
+	UVRRootComponent * Root;
+};
+
 /**
 * A capsule component that repositions its physics scene and rendering location to the camera/HMD's relative position.
 * Generally not to be used by itself unless on a base Pawn and not a character, the VRCharacter has been highly customized to correctly support it.
@@ -70,11 +88,22 @@ protected:
 	void SendPhysicsTransform(ETeleportType Teleport);
 	virtual void UpdateOverlaps(TArray<FOverlapInfo> const* NewPendingOverlaps = nullptr, bool bDoNotifies = true, const TArray<FOverlapInfo>* OverlapsAtEndLocation = nullptr) override;
 
-	const TArray<FOverlapInfo>* ConvertRotationOverlapsToCurrentOverlaps(TArray<FOverlapInfo>& OverlapsAtEndLocation, const TArray<FOverlapInfo>& CurrentOverlaps);
-	const TArray<FOverlapInfo>* ConvertSweptOverlapsToCurrentOverlaps(
-	TArray<FOverlapInfo>& OverlapsAtEndLocation, const TArray<FOverlapInfo>& SweptOverlaps, int32 SweptOverlapsIndex,
+	// If bForceOverlapQuery is true the end location is always queried instead of using the pending overlaps
+	void UpdateOverlapsImpl(const TArray<FOverlapInfo>* NewPendingOverlaps, bool bDoNotifies, const TInlineOverlapInfoArray* OverlapsAtEndLocation, bool bForceOverlapQuery = false);
+
+	const TInlineOverlapInfoArray* ConvertRotationOverlapsToCurrentOverlaps(TInlineOverlapInfoArray& OverlapsAtEndLocation, const TArray<FOverlapInfo>& CurrentOverlaps);
+	const TInlineOverlapInfoArray* ConvertSweptOverlapsToCurrentOverlaps(
+	TInlineOverlapInfoArray& OverlapsAtEndLocation, const TArray<FOverlapInfo>& SweptOverlaps, int32 SweptOverlapsIndex,
 	const FVector& EndLocation, const FQuat& EndRotationQuat);
 
+	// Overlap deferral state, see FVRRootScopedOverlapDeferral
+	int32 OverlapDeferralDepth;
+	bool bDeferredOverlapUpdatePending;
+	bool bDeferredOverlapsValidAtEnd;
+	TArray<FOverlapInfo> DeferredPendingOverlaps;
+
+	void FlushDeferredOverlaps();
+
 public:
 	void BeginPlay() override;
 
@@ -119,6 +148,39 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
 	TEnumAsByte<ECollisionChannel> WalkingCollisionOverride;
 
+	// If true the capsule holds its last pose until the HMD has moved further than the thresholds below,
+	// the held back movement is then applied (and swept) all at once instead of every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
+	bool bAccumulateHMDMovement;
+
+	// Distance (per axis) the HMD has to move before the capsule is updated when accumulating HMD movement
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary", meta = (EditCondition = "bAccumulateHMDMovement", ClampMin = "0.0", UIMin = "0.0"))
+	float HMDMovementThreshold;
+
+	// Rotation (per axis, in degrees) the HMD has to turn before the capsule is updated when accumulating HMD movement
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary", meta = (EditCondition = "bAccumulateHMDMovement", ClampMin = "0.0", UIMin = "0.0"))
+	float HMDRotationThreshold;
+
+	// If true the HMD pose is taken from the shared tracked pose filter (settings in the VRGlobalSettings)
+	// Jitter inside of the filter deadband is held so the capsule doesn't update, sweep or check overlaps for it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
+	bool bUseSharedPoseFilter;
+
+	// If true the walking collision override sweep is issued async and its result is applied on the next frame.
+	// Saves the blocking sweep on the game thread at the cost of a frame of latency on wall collisions.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary", meta = (EditCondition = "bUseWalkingCollisionOverride"))
+	bool bUseAsyncWalkingCollisionSweep;
+
+	// If true the VR character movement component defers overlap updates for its whole tick,
+	// so all of the moves it makes in a frame (including client replays) only update overlaps once at the end.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRExpansionLibrary")
+	bool bDeferOverlapUpdatesPerFrame;
+
+	bool IsDeferringOverlapUpdates() const
+	{
+		return OverlapDeferralDepth > 0;
+	}
+
 	/*ECollisionChannel GetVRCollisionObjectType()
 	{
 		if (bUseWalkingCollisionOverride)
@@ -138,6 +200,23 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "VRExpansionLibrary")
 	bool bHadRelativeMovement;
 
+	// Relative movement sweep params, cached so they aren't rebuilt every frame
+	FCollisionQueryParams RelativeMovementSweepParams;
+	FCollisionResponseParams RelativeMovementResponseParams;
+	bool bRelativeMovementSweepParamsDirty;
+	int32 RelativeMovementSweepIgnoreCount;
+
+	void UpdateRelativeMovementSweepParams();
+	virtual void OnComponentCollisionSettingsChanged() override;
+
+	// Async walking collision sweep from last frame and the movement that it was testing
+	FTraceHandle RelativeMovementAsyncSweepHandle;
+	FVector PendingAsyncSweepStart;
+	FVector PendingAsyncSweepDelta;
+
+	bool ShouldBlockRelativeMovement(const FHitResult & Hit, UVRBaseCharacterMovementComponent * CharMove) const;
+	void SetRelativeMovementDifference(const FVector & Delta);
+
 	FPrimitiveSceneProxy* CreateSceneProxy() override;
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
@@ -153,6 +232,7 @@ public:
 
 	private:
 		friend class FVRCharacterScopedMovementUpdate;
+		friend class FVRRootScopedOverlapDeferral;
 };
 
 
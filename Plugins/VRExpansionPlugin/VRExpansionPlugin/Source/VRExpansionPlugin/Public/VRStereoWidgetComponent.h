@@ -10,6 +10,8 @@
 
 #include "VRStereoWidgetComponent.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("VRStereoWidget"), STATGROUP_VRStereoWidget, STATCAT_Advanced);
+
 
 /**
 * A widget component that displays the widget in a stereo layer instead of in worldspace.
@@ -33,6 +35,8 @@ class VREXPANSIONPLUGIN_API UVRStereoWidgetComponent : public UWidgetComponent
 
 	virtual void UpdateRenderTarget(FIntPoint DesiredRenderTargetSize) override;
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual bool ShouldDrawWidget() const override;
+	virtual void SetWidget(UUserWidget* InWidget) override;
 
 	/**
 	* Change the quad size. This is the unscaled height and width, before component scale is applied.
@@ -41,9 +45,9 @@ class VREXPANSIONPLUGIN_API UVRStereoWidgetComponent : public UWidgetComponent
 	//UFUNCTION(BlueprintCallable, Category = "Components|Stereo Layer")
 		//void SetQuadSize(FVector2D InQuadSize);
 
-	// Manually mark the stereo layer texture for updating
-	//UFUNCTION(BlueprintCallable, Category = "Components|Stereo Layer")
-	//	void MarkTextureForUpdate();
+	// Manually mark the stereo layer texture for updating, needed when bLiveTexture is false and something other than the widget draws into the render target
+	UFUNCTION(BlueprintCallable, Category = "Components|Stereo Layer")
+		void MarkTextureForUpdate();
 
 	// If true, use Epics world locked stereo implementation instead of my own temp solution
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
@@ -72,6 +76,46 @@ class VREXPANSIONPLUGIN_API UVRStereoWidgetComponent : public UWidgetComponent
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
 		uint32 bQuadPreserveTextureRatio : 1;
 
+	/**
+	* True if the compositor should re-read the texture every frame (default, same as before this was exposed).
+	* If false the texture is only pushed on frames that the widget redrew, or when the render target is recreated or resized.
+	* Anything else that writes into the render target has to call MarkTextureForUpdate.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
+		uint32 bLiveTexture : 1;
+
+	/**
+	* If true the widget is only redrawn after MarkWidgetDirty is called (or the widget / render target changes) instead of on the redraw timer.
+	* The stereo layer texture is then only updated when that happens, which is good for HUD panels that rarely change.
+	* Slate can't render a sub rect of the widget here, so a dirty widget is always fully redrawn.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer")
+		bool bRedrawOnlyWhenDirty;
+
+	/** When redrawing only when dirty, still redraw after this many seconds so animations eventually show up, 0 = never */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StereoLayer", meta = (EditCondition = "bRedrawOnlyWhenDirty", ClampMin = "0.0", UIMin = "0.0"))
+		float MaxCleanRedrawInterval;
+
+	// Marks the widget content as changed so it is redrawn (and pushed to the stereo layer) on the next tick
+	UFUNCTION(BlueprintCallable, Category = "Components|Stereo Layer")
+		void MarkWidgetDirty();
+
+	// Number of times the widget has been drawn into its render target
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "StereoLayer")
+		int32 WidgetRedrawCount;
+
+	// Number of ticks that skipped drawing the widget because it was clean
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "StereoLayer")
+		int32 WidgetRedrawsSkippedCount;
+
+	// Number of times the stereo layer texture was pushed to the compositor (not counting continuous updates)
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "StereoLayer")
+		int32 LayerTextureUpdateCount;
+
+	// Resets the redraw counters above
+	UFUNCTION(BlueprintCallable, Category = "Components|Stereo Layer")
+		void ResetRedrawCounters();
+
 protected:
 	/** Texture displayed on the stereo layer (is stereocopic textures are supported on the platfrom and more than one texture is provided, this will be the right eye) **/
 	//UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "StereoLayer")
@@ -126,6 +170,21 @@ private:
 	/** Texture needs to be marked for update **/
 	bool bTextureNeedsUpdate;
 
+	/** Widget content has changed since it was last drawn **/
+	bool bWidgetContentDirty;
+
+	/** Last render target size, a new size needs a redraw **/
+	FIntPoint LastRenderTargetSize;
+
+	/** Last render target, only used for comparison, a new one needs a new layer desc **/
+	const UTextureRenderTarget2D * LastRenderTarget;
+
+	/** Real time of the last redraw, used for MaxCleanRedrawInterval **/
+	float LastRedrawTime;
+
+	/** Last frames live texture state, changing it needs a new layer desc **/
+	bool bLastLiveTexture;
+
 	/** IStereoLayer id, 0 is unassigned **/
 	uint32 LayerId;
 
@@ -1,14 +1,22 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EQC_AttackTarget.h"
+#include "Empath.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EmpathAIController.h"
 #include "Runtime/Engine/Public/EngineUtils.h"
 #include "EnvironmentQuery/EQSTestingPawn.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Actor.h"
 
+// Stats for UE Profiler
+DECLARE_CYCLE_STAT(TEXT("EQS Context Attack Target"), STAT_EMPATH_EQC_AttackTarget, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Context Attack Target Calls"), STAT_EMPATH_EQC_AttackTargetCalls, STATGROUP_EMPATH);
+
 void UEQC_AttackTarget::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_EQC_AttackTarget);
+	INC_DWORD_STAT(STAT_EMPATH_EQC_AttackTargetCalls);
+
 	AActor* AttackTarget = nullptr;
 
 	APawn* const QueryOwner = Cast<APawn>(QueryInstance.Owner.Get());
@@ -1,6 +1,7 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EQC_LastKnownPlayerLocation.h"
+#include "Empath.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EmpathAIController.h"
 #include "EmpathAIManager.h"
@@ -8,8 +9,15 @@
 #include "EnvironmentQuery/EQSTestingPawn.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
 
+// Stats for UE Profiler
+DECLARE_CYCLE_STAT(TEXT("EQS Context Last Known Player Location"), STAT_EMPATH_EQC_LastKnownPlayerLocation, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Context Last Known Player Location Calls"), STAT_EMPATH_EQC_LastKnownPlayerLocationCalls, STATGROUP_EMPATH);
+
 void UEQC_LastKnownPlayerLocation::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_EQC_LastKnownPlayerLocation);
+	INC_DWORD_STAT(STAT_EMPATH_EQC_LastKnownPlayerLocationCalls);
+
 	FVector TargetLocation(0.f);
 
 	APawn* const QueryOwner = Cast<APawn>(QueryInstance.Owner.Get());
@@ -1,37 +1,56 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EQC_PlayerLocation.h"
+#include "Empath.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
 #include "EmpathAIController.h"
 #include "EmpathPlayerCharacter.h"
+#include "EmpathAIManager.h"
+#include "EmpathFunctionLibrary.h"
 #include "Runtime/Engine/Public/EngineUtils.h"
 #include "EnvironmentQuery/EQSTestingPawn.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
 
+// Stats for UE Profiler
+DECLARE_CYCLE_STAT(TEXT("EQS Context Player Location"), STAT_EMPATH_EQC_PlayerLocation, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Context Player Location Calls"), STAT_EMPATH_EQC_PlayerLocationCalls, STATGROUP_EMPATH);
+
 void UEQC_PlayerLocation::ProvideContext(FEnvQueryInstance& QueryInstance, FEnvQueryContextData& ContextData) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_EQC_PlayerLocation);
+	INC_DWORD_STAT(STAT_EMPATH_EQC_PlayerLocationCalls);
+
 	FVector TargetLocation(0.f);
 	APawn* const QueryOwner = Cast<APawn>(QueryInstance.Owner.Get());
 	if (QueryOwner)
 	{
 		bool bFoundTarget = false;
 		TargetLocation = QueryOwner->GetActorLocation(); // Fallback to self location if no target location.
-		AController* PlayerCon = GetWorld()->GetFirstPlayerController();
-		if (PlayerCon)
+		// Resolve through the AI manager so that every query this frame shares the lookup
+		AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(QueryOwner);
+		if (AIManager)
+		{
+			bFoundTarget = AIManager->GetQueryContextPlayerLocation(TargetLocation);
+		}
+		else
 		{
-			APawn* PlayerPawn = PlayerCon->GetPawn();
-			if (PlayerPawn)
+			AController* PlayerCon = GetWorld()->GetFirstPlayerController();
+			if (PlayerCon)
 			{
-				AEmpathPlayerCharacter* VRChar = Cast<AEmpathPlayerCharacter>(PlayerPawn);
-				if (VRChar)
-				{
-					TargetLocation = VRChar->GetVRLocation();
-				}
-				else
+				APawn* PlayerPawn = PlayerCon->GetPawn();
+				if (PlayerPawn)
 				{
-					TargetLocation = PlayerPawn->GetActorLocation();
+					AEmpathPlayerCharacter* VRChar = Cast<AEmpathPlayerCharacter>(PlayerPawn);
+					if (VRChar)
+					{
+						TargetLocation = VRChar->GetVRLocation();
+					}
+					else
+					{
+						TargetLocation = PlayerPawn->GetActorLocation();
+					}
+					bFoundTarget = true;
 				}
-				bFoundTarget = true;
 			}
 		}
 
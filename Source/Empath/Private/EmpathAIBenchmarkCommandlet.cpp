@@ -0,0 +1,374 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#include "EmpathAIBenchmarkCommandlet.h"
+#include "EmpathAIManager.h"
+#include "EmpathAIController.h"
+#include "EmpathCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/WorldSettings.h"
+#include "Components/StaticMeshComponent.h"
+#include "AI/Navigation/NavigationSystem.h"
+#include "AI/Navigation/NavigationData.h"
+#include "AI/Navigation/RecastNavMesh.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+// Log categories
+DEFINE_LOG_CATEGORY_STATIC(LogEmpathAIBenchmark, Log, All);
+
+UEmpathAIBenchmarkCommandlet::UEmpathAIBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UEmpathAIBenchmarkCommandlet::Main(const FString& Params)
+{
+	// Parse settings
+	int32 NumCharacters = 64;
+	int32 NumTicks = 600;
+	int32 Seed = 1234;
+	float DeltaTime = 1.0f / 60.0f;
+	float ArenaSize = 6000.0f;
+	int32 NumObstacles = 40;
+	int32 NoisesPerTick = 2;
+	int32 PathsPerTick = 8;
+	int32 QueriesPerTick = 4;
+	FString CharacterClassPath;
+	FString QueryPath;
+	FString OutputFileName = TEXT("AIBenchmark.json");
+	FParse::Value(*Params, TEXT("Characters="), NumCharacters);
+	FParse::Value(*Params, TEXT("Ticks="), NumTicks);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	FParse::Value(*Params, TEXT("ArenaSize="), ArenaSize);
+	FParse::Value(*Params, TEXT("Obstacles="), NumObstacles);
+	FParse::Value(*Params, TEXT("NoisesPerTick="), NoisesPerTick);
+	FParse::Value(*Params, TEXT("PathsPerTick="), PathsPerTick);
+	FParse::Value(*Params, TEXT("QueriesPerTick="), QueriesPerTick);
+	FParse::Value(*Params, TEXT("CharacterClass="), CharacterClassPath);
+	FParse::Value(*Params, TEXT("Query="), QueryPath);
+	FParse::Value(*Params, TEXT("Output="), OutputFileName);
+	NumCharacters = FMath::Max(NumCharacters, 1);
+	NumTicks = FMath::Max(NumTicks, 1);
+
+	UClass* CharacterClass = AEmpathCharacter::StaticClass();
+	if (!CharacterClassPath.IsEmpty())
+	{
+		CharacterClass = LoadClass<AEmpathCharacter>(nullptr, *CharacterClassPath);
+		if (!CharacterClass)
+		{
+			UE_LOG(LogEmpathAIBenchmark, Error, TEXT("Could not load character class %s"), *CharacterClassPath);
+			return 1;
+		}
+	}
+
+	UEnvQuery* Query = nullptr;
+	if (!QueryPath.IsEmpty())
+	{
+		Query = LoadObject<UEnvQuery>(nullptr, *QueryPath);
+		if (!Query)
+		{
+			UE_LOG(LogEmpathAIBenchmark, Warning, TEXT("Could not load EQS query %s, EQS will not be measured"), *QueryPath);
+		}
+	}
+
+	FRandomStream Random(Seed);
+
+	// The arena has no bounds volume, so let the whole world be navigable
+	GConfig->SetBool(TEXT("/Script/Engine.NavigationSystem"), TEXT("bWholeWorldNavigable"), true, GEngineIni);
+	UNavigationSystem::StaticClass()->GetDefaultObject()->ReloadConfig();
+
+	// Game worlds only get a navmesh generator with dynamic runtime generation, without it the navmesh stays empty
+	GConfig->SetString(TEXT("/Script/Engine.RecastNavMesh"), TEXT("RuntimeGeneration"), TEXT("Dynamic"), GEngineIni);
+	ARecastNavMesh::StaticClass()->GetDefaultObject()->ReloadConfig();
+
+	// Create the world
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, FName(TEXT("EmpathAIBenchmark")));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	BuildArena(World, Random, ArenaSize, NumObstacles);
+
+	World->InitializeActorsForPlay(FURL());
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	UNavigationSystem* NavSys = World->GetNavigationSystem();
+	ANavigationData* NavData = nullptr;
+	if (NavSys)
+	{
+		NavSys->Build();
+		NavData = NavSys->GetMainNavData(FNavigationSystem::DontCreate);
+	}
+
+	// Without tiles the crowd never pathfinds and the results would be meaningless
+	ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavData);
+	if (!NavMesh || NavMesh->GetNavMeshTilesCount() == 0)
+	{
+		UE_LOG(LogEmpathAIBenchmark, Error, TEXT("The navmesh has no tiles after the build, aborting the benchmark"));
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return 1;
+	}
+
+	// Spawn the AI manager, the fake player target, and the crowd
+	AEmpathAIManager* AIManager = World->SpawnActor<AEmpathAIManager>();
+	ATargetPoint* FakeTarget = World->SpawnActor<ATargetPoint>(FVector(0.0f, 0.0f, 100.0f), FRotator::ZeroRotator);
+	AIManager->AddSecondaryTarget(FakeTarget, 1.0f, 1.0f, 50.0f);
+
+	const float HalfArena = ArenaSize * 0.5f;
+	TArray<AEmpathAIController*> AIControllers;
+	AIControllers.Reserve(NumCharacters);
+	for (int32 Idx = 0; Idx < NumCharacters; ++Idx)
+	{
+		const FVector SpawnLoc(Random.FRandRange(-HalfArena, HalfArena), Random.FRandRange(-HalfArena, HalfArena), 150.0f);
+		const FRotator SpawnRot(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f);
+		AEmpathCharacter* NewChar = AIManager->SpawnPooledCharacter(CharacterClass, FTransform(SpawnRot, SpawnLoc));
+		if (!NewChar)
+		{
+			continue;
+		}
+
+		if (!NewChar->GetController())
+		{
+			NewChar->SpawnDefaultController();
+		}
+
+		AEmpathAIController* AICon = Cast<AEmpathAIController>(NewChar->GetController());
+		if (!AICon)
+		{
+			continue;
+		}
+
+		// There is no game mode to hand out the AI manager
+		AICon->RegisterAIManager(AIManager);
+
+		// Seeded behavior mix
+		const float BehaviorRoll = Random.FRand();
+		if (BehaviorRoll < 0.6f)
+		{
+			AICon->SetBehaviorModeSearchAndDestroy(FakeTarget);
+		}
+		else if (BehaviorRoll < 0.85f)
+		{
+			AICon->SetBehaviorModeDefend(FakeTarget);
+		}
+		else
+		{
+			AICon->SetBehaviorModeFlee(FakeTarget);
+		}
+		AIControllers.Add(AICon);
+	}
+
+	UE_LOG(LogEmpathAIBenchmark, Display, TEXT("Simulating %d AI for %d ticks (seed %d)"), AIControllers.Num(), NumTicks, Seed);
+
+	// Simulate
+	TArray<double> FrameSamples;
+	FrameSamples.Reserve(NumTicks);
+	FSubsystemSamples Targeting(TEXT("Targeting"));
+	FSubsystemSamples Vision(TEXT("Vision"));
+	FSubsystemSamples Noise(TEXT("ReportNoise"));
+	FSubsystemSamples EQS(TEXT("EQS"));
+	FSubsystemSamples Pathing(TEXT("Pathing"));
+	FSubsystemSamples* const Subsystems[] = { &Targeting, &Vision, &Noise, &EQS, &Pathing };
+	for (FSubsystemSamples* Subsystem : Subsystems)
+	{
+		Subsystem->Samples.Reserve(NumTicks);
+	}
+	UEnvQueryManager* EQSManager = UEnvQueryManager::GetCurrent(World);
+
+#if STATS
+	const uint64 StartMallocCalls = (uint64)FMalloc::TotalMallocCalls;
+	TArray<double> AllocSamples;
+	AllocSamples.Reserve(NumTicks);
+#endif
+
+	for (int32 TickIdx = 0; TickIdx < NumTicks; ++TickIdx)
+	{
+		// Walk the fake player around the arena so targeting and vision results change
+		const float TargetAngle = TickIdx * DeltaTime * 0.5f;
+		FakeTarget->SetActorLocation(FVector(FMath::Cos(TargetAngle) * HalfArena * 0.5f, FMath::Sin(TargetAngle) * HalfArena * 0.5f, 100.0f));
+
+#if STATS
+		const uint64 TickStartMallocCalls = (uint64)FMalloc::TotalMallocCalls;
+#endif
+		uint32 StartCycles = FPlatformTime::Cycles();
+		World->Tick(LEVELTICK_All, DeltaTime);
+		FrameSamples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+#if STATS
+		AllocSamples.Add((double)((uint64)FMalloc::TotalMallocCalls - TickStartMallocCalls));
+#endif
+		GFrameCounter++;
+
+		// Targeting and vision for the whole crowd
+		StartCycles = FPlatformTime::Cycles();
+		for (AEmpathAIController* AICon : AIControllers)
+		{
+			AICon->UpdateAttackTarget();
+		}
+		Targeting.Samples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+		Targeting.Calls += AIControllers.Num();
+
+		StartCycles = FPlatformTime::Cycles();
+		for (AEmpathAIController* AICon : AIControllers)
+		{
+			AICon->UpdateVision(true);
+		}
+		Vision.Samples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+		Vision.Calls += AIControllers.Num();
+
+		// Noise at seeded locations
+		StartCycles = FPlatformTime::Cycles();
+		for (int32 NoiseIdx = 0; NoiseIdx < NoisesPerTick; ++NoiseIdx)
+		{
+			const FVector NoiseLoc(Random.FRandRange(-HalfArena, HalfArena), Random.FRandRange(-HalfArena, HalfArena), 100.0f);
+			AIManager->ReportNoise(FakeTarget, FakeTarget, NoiseLoc, Random.FRandRange(500.0f, 2000.0f));
+		}
+		Noise.Samples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+		Noise.Calls += NoisesPerTick;
+
+		if (AIControllers.Num() == 0)
+		{
+			continue;
+		}
+
+		// EQS for a seeded sample of the crowd
+		StartCycles = FPlatformTime::Cycles();
+		if (Query && EQSManager)
+		{
+			for (int32 QueryIdx = 0; QueryIdx < QueriesPerTick; ++QueryIdx)
+			{
+				AEmpathAIController* AICon = AIControllers[Random.RandHelper(AIControllers.Num())];
+				if (AICon->GetPawn())
+				{
+					FEnvQueryRequest Request(Query, AICon->GetPawn());
+					EQSManager->RunInstantQuery(Request, EEnvQueryRunMode::SingleResult);
+					EQS.Calls++;
+				}
+			}
+		}
+		EQS.Samples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+
+		// Paths to the target for a seeded sample of the crowd
+		StartCycles = FPlatformTime::Cycles();
+		if (NavSys && NavData)
+		{
+			for (int32 PathIdx = 0; PathIdx < PathsPerTick; ++PathIdx)
+			{
+				AEmpathAIController* AICon = AIControllers[Random.RandHelper(AIControllers.Num())];
+				if (AICon->GetPawn())
+				{
+					FPathFindingQuery PathQuery(AICon, *NavData, AICon->GetPawn()->GetNavAgentLocation(), FakeTarget->GetActorLocation());
+					NavSys->FindPathSync(PathQuery);
+					Pathing.Calls++;
+				}
+			}
+		}
+		Pathing.Samples.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles));
+	}
+
+	// Write the report
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"characters\": %d,\n\t\"ticks\": %d,\n\t\"seed\": %d,\n\t\"deltaTime\": %f,\n"), AIControllers.Num(), NumTicks, Seed, DeltaTime);
+	Json += FString::Printf(TEXT("\t\"frameMs\": %s,\n"), *SamplesToJson(FrameSamples));
+#if STATS
+	Json += FString::Printf(TEXT("\t\"totalAllocations\": %llu,\n"), (uint64)FMalloc::TotalMallocCalls - StartMallocCalls);
+	Json += FString::Printf(TEXT("\t\"frameAllocations\": %s,\n"), *SamplesToJson(AllocSamples));
+#endif
+	Json += TEXT("\t\"subsystems\": {\n");
+	for (int32 Idx = 0; Idx < ARRAY_COUNT(Subsystems); ++Idx)
+	{
+		FSubsystemSamples* Subsystem = Subsystems[Idx];
+		Json += FString::Printf(TEXT("\t\t\"%s\": { \"calls\": %d, \"tickMs\": %s }%s\n"), *Subsystem->Name, Subsystem->Calls, *SamplesToJson(Subsystem->Samples), Idx < ARRAY_COUNT(Subsystems) - 1 ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t}\n}\n");
+
+	const FString OutputPath = FPaths::IsRelative(OutputFileName) ? FPaths::ProfilingDir() / OutputFileName : OutputFileName;
+	const bool bSaved = FFileHelper::SaveStringToFile(Json, *OutputPath);
+	UE_LOG(LogEmpathAIBenchmark, Display, TEXT("%s"), *Json);
+	if (bSaved)
+	{
+		UE_LOG(LogEmpathAIBenchmark, Display, TEXT("Wrote AI benchmark results to %s"), *OutputPath);
+	}
+	else
+	{
+		UE_LOG(LogEmpathAIBenchmark, Error, TEXT("Could not write AI benchmark results to %s"), *OutputPath);
+	}
+
+	// Clean up
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return bSaved ? 0 : 1;
+}
+
+void UEmpathAIBenchmarkCommandlet::BuildArena(UWorld* World, FRandomStream& Random, float ArenaSize, int32 NumObstacles) const
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh)
+	{
+		UE_LOG(LogEmpathAIBenchmark, Error, TEXT("Could not load the engine cube mesh for the arena"));
+		return;
+	}
+
+	// The engine cube is 100 units on each side, centered on its origin
+	auto SpawnBox = [World, CubeMesh](FVector const& Center, FVector const& Size)
+	{
+		AStaticMeshActor* Box = World->SpawnActor<AStaticMeshActor>(Center, FRotator::ZeroRotator);
+		if (Box)
+		{
+			Box->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+			Box->SetActorScale3D(Size / 100.0f);
+		}
+	};
+
+	// Floor
+	SpawnBox(FVector(0.0f, 0.0f, -50.0f), FVector(ArenaSize, ArenaSize, 100.0f));
+
+	// Seeded obstacles
+	const float HalfArena = ArenaSize * 0.5f;
+	for (int32 Idx = 0; Idx < NumObstacles; ++Idx)
+	{
+		const FVector Size(Random.FRandRange(100.0f, 600.0f), Random.FRandRange(100.0f, 600.0f), Random.FRandRange(100.0f, 400.0f));
+		const FVector Center(Random.FRandRange(-HalfArena, HalfArena), Random.FRandRange(-HalfArena, HalfArena), Size.Z * 0.5f);
+		SpawnBox(Center, Size);
+	}
+}
+
+double UEmpathAIBenchmarkCommandlet::GetPercentile(TArray<double>& Samples, float Percentile)
+{
+	if (Samples.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	Samples.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Samples.Num()) - 1, 0, Samples.Num() - 1);
+	return Samples[Index];
+}
+
+FString UEmpathAIBenchmarkCommandlet::SamplesToJson(TArray<double>& Samples)
+{
+	double Total = 0.0;
+	for (double Sample : Samples)
+	{
+		Total += Sample;
+	}
+	const double Mean = Samples.Num() > 0 ? Total / Samples.Num() : 0.0;
+
+	return FString::Printf(TEXT("{ \"mean\": %f, \"p50\": %f, \"p95\": %f, \"p99\": %f, \"max\": %f }"),
+		Mean,
+		GetPercentile(Samples, 0.5f),
+		GetPercentile(Samples, 0.95f),
+		GetPercentile(Samples, 0.99f),
+		GetPercentile(Samples, 1.0f));
+}
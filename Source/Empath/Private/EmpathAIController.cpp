@@ -1,6 +1,7 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathAIController.h"
+#include "Empath.h"
 #include "EmpathAIManager.h"
 #include "EmpathGameModeBase.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -53,9 +54,12 @@ static const auto AIVisionDebugLifetime = IConsoleManager::Get().FindConsoleVari
 #endif
 
 // Stats for UE Profiler
-DECLARE_CYCLE_STAT(TEXT("AI Update Attack Target"), STAT_EMPATH_UpdateAttackTarget, STATGROUP_EMPATH_AICon);
-DECLARE_CYCLE_STAT(TEXT("AI Update Vision"), STAT_EMPATH_UpdateVision, STATGROUP_EMPATH_AICon);
+DECLARE_CYCLE_STAT(TEXT("AI Update Attack Target"), STAT_EMPATH_UpdateAttackTarget, STATGROUP_EMPATH);
+DECLARE_CYCLE_STAT(TEXT("AI Update Vision"), STAT_EMPATH_UpdateVision, STATGROUP_EMPATH);
 DECLARE_CYCLE_STAT(TEXT("AI Jump Anim Calculation"), STAT_EMPATH_JumpAnim, STATGROUP_EMPATH_AICon);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Update Attack Target Calls"), STAT_EMPATH_UpdateAttackTargetCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Attack Targets Scored"), STAT_EMPATH_AttackTargetsScored, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Update Vision Calls"), STAT_EMPATH_UpdateVisionCalls, STATGROUP_EMPATH);
 
 // Cannot statics in class initializer so initialize here
 const float AEmpathAIController::MinTargetSelectionScore = -9999999.0f;
@@ -152,6 +156,69 @@ void AEmpathAIController::RegisterAIManager(AEmpathAIManager* RegisteringAIManag
 	}
 }
 
+void AEmpathAIController::OnReturnedToPool()
+{
+	// Our character should already be dead, but ensure we have stopped everything in case we are pooled directly
+	UnregisterAIManager();
+	ReleaseAllClaimedNavLinks();
+	StopMovement();
+	ClearFocus(EAIFocusPriority::Gameplay);
+	UBrainComponent* const Brain = GetBrainComponent();
+	if (Brain)
+	{
+		Brain->StopLogic(TEXT("Returned To Pool"));
+	}
+
+	// Ignore any vision trace still in flight
+	LOSTraceHandleToIgnore = CurrentLOSTraceHandle;
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	SetActorTickEnabled(false);
+}
+
+void AEmpathAIController::ResetFromPool()
+{
+	// Clear all blackboard state from our previous life, except for the self actor which stays our pawn
+	if (Blackboard)
+	{
+		FBlackboard::FKey const SelfKey = Blackboard->GetKeyID(FBlackboard::KeySelf);
+		for (int32 KeyIdx = 0; KeyIdx < Blackboard->GetNumKeys(); ++KeyIdx)
+		{
+			if (KeyIdx != SelfKey)
+			{
+				Blackboard->ClearValue(KeyIdx);
+			}
+		}
+		Blackboard->SetValueAsObject(FBlackboard::KeySelf, GetPawn());
+	}
+
+	// Reset movement and targeting variables
+	CurrentAttackTargetRadius = 0.0f;
+	LastSawAttackTargetTeleportTime = 0.0f;
+	LastCapsuleBumpWhileMovingTime = 0.0f;
+	NumConsecutiveBumpsWhileMoving = 0;
+	bShouldReposition = false;
+	ClearCustomAimLocation();
+
+	// Rejoin the AI manager
+	SetActorTickEnabled(true);
+	RegisterAIManager(UEmpathFunctionLibrary::GetAIManager(this));
+
+	// Restart the behavior tree
+	UBrainComponent* const Brain = GetBrainComponent();
+	if (Brain)
+	{
+		Brain->RestartLogic();
+		AEmpathCharacter* const EmpathChar = GetEmpathChar();
+		if (EmpathChar)
+		{
+			EmpathChar->ReceiveAIInitalized();
+		}
+	}
+
+	ReceiveResetFromPool();
+}
+
 EEmpathTeam AEmpathAIController::GetTeamNum_Implementation() const
 {
 	return Team;
@@ -703,6 +770,7 @@ void AEmpathAIController::UpdateAttackTarget()
 {
 	// Track how long it takes to complete this function for the profiler
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_UpdateAttackTarget);
+	INC_DWORD_STAT(STAT_EMPATH_UpdateAttackTargetCalls);
 
 	// If we auto target the player, then simply set them as the attack target
 	if (bAutoTargetPlayer)
@@ -740,6 +808,7 @@ void AEmpathAIController::UpdateAttackTarget()
 				{
 					if (CurrentTarget.IsValid())
 					{
+						INC_DWORD_STAT(STAT_EMPATH_AttackTargetsScored);
 						float const Score = GetTargetSelectionScore(CurrentTarget.TargetActor,
 							CurrentTarget.TargetingRatio,
 							CurrentTarget.TargetPreference,
@@ -766,6 +835,7 @@ void AEmpathAIController::UpdateAttackTarget()
 				AEmpathPlayerCharacter* const PlayerTarget = Cast<AEmpathPlayerCharacter>(PlayerController->GetPawn());
 				if (PlayerTarget && !PlayerTarget->IsDead())
 				{
+					INC_DWORD_STAT(STAT_EMPATH_AttackTargetsScored);
 					float const PlayerScore = GetTargetSelectionScore(PlayerTarget,
 						0.0f,
 						0.0f,
@@ -790,6 +860,7 @@ void AEmpathAIController::UpdateVision(bool bTestImmediately)
 {
 	// Track how long it takes to complete this function for the profiler
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_UpdateVision);
+	INC_DWORD_STAT(STAT_EMPATH_UpdateVisionCalls);
 
 	// Check if we can see the target
 	UWorld* const World = GetWorld();
@@ -1349,18 +1420,27 @@ void AEmpathAIController::UnregisterAIManager()
 {
 	if (AIManager)
 	{
-		//// Remove us from the list of AI cons
-		AIManager->EmpathAICons.RemoveAtSwap(AIManagerIndex);
-
-		// Update the index we swapped with
-		if (AIManagerIndex < AIManager->EmpathAICons.Num())
+		// Remove us from the list of AI cons, falling back to a search if our index is out of date
+		TArray<AEmpathAIController*>& EmpathAICons = AIManager->EmpathAICons;
+		if (!EmpathAICons.IsValidIndex(AIManagerIndex) || EmpathAICons[AIManagerIndex] != this)
 		{
-			AEmpathAIController* SwappedAICon = AIManager->EmpathAICons[AIManagerIndex];
-			if (SwappedAICon)
+			AIManagerIndex = EmpathAICons.Find(this);
+		}
+		if (AIManagerIndex != INDEX_NONE)
+		{
+			EmpathAICons.RemoveAtSwap(AIManagerIndex);
+
+			// Update the index of the AI con we swapped with
+			if (AIManagerIndex < EmpathAICons.Num())
 			{
-				//SwappedAICon->AIManagerIndex = AIManagerIndex;
+				AEmpathAIController* SwappedAICon = EmpathAICons[AIManagerIndex];
+				if (SwappedAICon)
+				{
+					SwappedAICon->AIManagerIndex = AIManagerIndex;
+				}
 			}
 		}
+		AIManagerIndex = INDEX_NONE;
 
 		AIManager->CheckForAwareAIs();
 		AIManager = nullptr;
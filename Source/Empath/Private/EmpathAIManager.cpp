@@ -4,15 +4,55 @@
 #include "EmpathAIController.h"
 #include "Runtime/Engine/Public/EngineUtils.h"
 #include "EmpathPlayerCharacter.h"
+#include "EmpathCharacter.h"
 #include "EmpathTypes.h"
 
 // Stats for UE Profiler
 DECLARE_CYCLE_STAT(TEXT("AI Hearing Checks"), STAT_EMPATH_HearingChecks, STATGROUP_EMPATH_AIManager);
+DECLARE_CYCLE_STAT(TEXT("Ragdoll LOD Update"), STAT_EMPATH_RagdollLOD, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulating Ragdolls"), STAT_EMPATH_SimulatingRagdolls, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frozen Ragdolls"), STAT_EMPATH_FrozenRagdolls, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Snapshot Ragdolls"), STAT_EMPATH_SnapshotRagdolls, STATGROUP_EMPATH_AIManager);
+DECLARE_CYCLE_STAT(TEXT("Spawn Pooled Character"), STAT_EMPATH_SpawnPooledCharacter, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character Pool Hits"), STAT_EMPATH_CharacterPoolHits, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character Pool Misses"), STAT_EMPATH_CharacterPoolMisses, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Characters"), STAT_EMPATH_PooledCharacters, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Context Cache Hits"), STAT_EMPATH_QueryContextCacheHits, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Context Cache Misses"), STAT_EMPATH_QueryContextCacheMisses, STATGROUP_EMPATH_AIManager);
+DECLARE_CYCLE_STAT(TEXT("Nav Recovery Scheduling"), STAT_EMPATH_NavRecoveryScheduling, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Recovery Queries Queued"), STAT_EMPATH_NavRecoveryQueued, STATGROUP_EMPATH_AIManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nav Recovery Queries Started"), STAT_EMPATH_NavRecoveryStarted, STATGROUP_EMPATH_AIManager);
 
 // Log categories
 DEFINE_LOG_CATEGORY_STATIC(LogAIManager, Log, All);
 
+// Console variable setup so we can tune the ragdoll budget from the console
+static TAutoConsoleVariable<int32> CVarEmpathMaxSimulatingRagdolls(
+	TEXT("Empath.MaxSimulatingRagdolls"),
+	8,
+	TEXT("Maximum number of dead ragdolls allowed to simulate at once. Oldest and farthest ragdolls are frozen first.\n")
+	TEXT("<0: Unlimited"),
+	ECVF_Scalability);
+static const auto MaxSimulatingRagdolls = IConsoleManager::Get().FindConsoleVariable(TEXT("Empath.MaxSimulatingRagdolls"));
+
+static TAutoConsoleVariable<int32> CVarEmpathCharacterPoolMaxPerClass(
+	TEXT("Empath.CharacterPoolMaxPerClass"),
+	16,
+	TEXT("Maximum number of inactive characters of each class kept in the character pool. Dead characters beyond this are destroyed.\n")
+	TEXT("0: Pooling disabled"),
+	ECVF_Scalability);
+static const auto CharacterPoolMaxPerClass = IConsoleManager::Get().FindConsoleVariable(TEXT("Empath.CharacterPoolMaxPerClass"));
+
+static TAutoConsoleVariable<int32> CVarEmpathNavRecoveryQueriesPerFrame(
+	TEXT("Empath.NavRecoveryQueriesPerFrame"),
+	4,
+	TEXT("Maximum number of nav recovery checks started per frame across all characters. Characters nearest the player go first.\n")
+	TEXT("<=0: Unlimited"),
+	ECVF_Scalability);
+static const auto NavRecoveryQueriesPerFrame = IConsoleManager::Get().FindConsoleVariable(TEXT("Empath.NavRecoveryQueriesPerFrame"));
+
 const float AEmpathAIManager::HearingDisconnectDist = 500.0f;
+const float AEmpathAIManager::RagdollEvictionDistanceScale = 500.0f;
 
 // Allows us to get IsValid from SecondaryAttackTarget structs
 bool FSecondaryAttackTarget::IsValid() const
@@ -33,6 +73,9 @@ AEmpathAIManager::AEmpathAIManager()
 	bIsPlayerLocationKnown = false;
 	LostPlayerTimeThreshold = 0.5f;
 	StartSearchingTimeThreshold = 3.0f;
+	RagdollLODUpdateInterval = 0.25f;
+	QueryContextPlayerLocation = FVector::ZeroVector;
+	QueryContextPlayerLocationFrame = MAX_uint64;
 }
 
 void AEmpathAIManager::OnPlayerDied(FHitResult const& KillingHitInfo, FVector KillingHitImpulseDir, const AController* DeathInstigator, const AActor* DeathCauser, const UDamageType* DeathDamageType)
@@ -40,6 +83,7 @@ void AEmpathAIManager::OnPlayerDied(FHitResult const& KillingHitInfo, FVector Ki
 	PlayerAwarenessState = EEmpathPlayerAwarenessState::PresenceNotKnown;
 	OnNewPlayerAwarenessState.Broadcast(PlayerAwarenessState);
 	bIsPlayerLocationKnown = false;
+	InvalidateQueryContextCache();
 }
 
 // Called when the game starts or when spawned
@@ -80,6 +124,11 @@ void AEmpathAIManager::BeginPlay()
 	{
 		UE_LOG(LogAIManager, Warning, TEXT("%s: ERROR: Player not found!"), *GetNameSafe(this));
 	}
+
+	// Start the ragdoll LOD
+	GetWorldTimerManager().SetTimer(RagdollLODTimerHandle,
+		FTimerDelegate::CreateUObject(this, &AEmpathAIManager::UpdateRagdollLOD),
+		RagdollLODUpdateInterval, true);
 }
 
 // Called every frame
@@ -87,6 +136,8 @@ void AEmpathAIManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	UpdateNavRecoveryQueries();
+
 }
 
 void AEmpathAIManager::CleanUpSecondaryTargets()
@@ -224,6 +275,9 @@ bool AEmpathAIManager::IsPlayerPotentiallyLost() const
 
 void AEmpathAIManager::OnPlayerTeleported(AActor* Player, FVector Origin, FVector Destination)
 {
+	// Any cached player context is now out of date
+	InvalidateQueryContextCache();
+
 	if (PlayerAwarenessState == EEmpathPlayerAwarenessState::KnownLocation)
 	{
 		PlayerAwarenessState = EEmpathPlayerAwarenessState::PotentiallyLost;
@@ -368,4 +422,333 @@ void AEmpathAIManager::ReportNoise(AActor* NoiseInstigator, AActor* NoiseMaker,
 		// TODO: Flag area for AI to investigate
 	}
 	return;
-}
\ No newline at end of file
+}
+
+void AEmpathAIManager::RegisterDeadRagdoll(AEmpathCharacter* DeadCharacter)
+{
+	if (DeadCharacter)
+	{
+		DeadRagdolls.AddUnique(DeadCharacter);
+	}
+}
+
+void AEmpathAIManager::UnregisterDeadRagdoll(AEmpathCharacter* DeadCharacter)
+{
+	DeadRagdolls.RemoveSwap(DeadCharacter);
+}
+
+void AEmpathAIManager::UpdateRagdollLOD()
+{
+	// Track how long it takes to complete this function for the profiler
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_RagdollLOD);
+
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Get the player's view location to measure distance against
+	bool bHasViewLocation = false;
+	FVector ViewLocation = FVector::ZeroVector;
+	APlayerController* const PlayerCon = World->GetFirstPlayerController();
+	if (PlayerCon)
+	{
+		FRotator ViewRotation;
+		PlayerCon->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasViewLocation = true;
+	}
+
+	// Ragdolls that are still simulating, along with how eagerly they should be evicted if we are over budget
+	struct FRagdollEvictionCandidate
+	{
+		AEmpathCharacter* Character;
+		float EvictionScore;
+	};
+	TArray<FRagdollEvictionCandidate, TInlineAllocator<16>> SimulatingRagdolls;
+
+	float const CurrentTime = World->GetTimeSeconds();
+	int32 NumFrozen = 0;
+	int32 NumSnapshot = 0;
+	for (int32 Idx = 0; Idx < DeadRagdolls.Num(); ++Idx)
+	{
+		// Remove any stale ragdolls
+		AEmpathCharacter* const DeadChar = DeadRagdolls[Idx];
+		if (DeadChar == nullptr || DeadChar->IsPendingKill())
+		{
+			DeadRagdolls.RemoveAtSwap(Idx, 1, false);
+			--Idx;
+			continue;
+		}
+
+		float const TimeInState = CurrentTime - DeadChar->GetRagdollLODStateStartTime();
+		switch (DeadChar->GetRagdollLODState())
+		{
+		case EEmpathRagdollLODState::Simulating:
+		{
+			// Freeze the ragdoll if it has settled somewhere the player is unlikely to notice
+			float const DistToView = bHasViewLocation ? (DeadChar->GetMesh()->Bounds.Origin - ViewLocation).Size() : 0.0f;
+			bool const bFarAway = DistToView > DeadChar->RagdollLODFreezeDistance;
+			bool const bOffscreen = !DeadChar->WasRecentlyRendered(DeadChar->RagdollLODOffscreenTime);
+			if ((bFarAway || bOffscreen) && DeadChar->IsRagdollAtRest() && DeadChar->FreezeRagdoll())
+			{
+				++NumFrozen;
+			}
+			else
+			{
+				// Older and farther ragdolls are evicted first
+				FRagdollEvictionCandidate Candidate;
+				Candidate.Character = DeadChar;
+				Candidate.EvictionScore = TimeInState + (DistToView / RagdollEvictionDistanceScale);
+				SimulatingRagdolls.Add(Candidate);
+			}
+			break;
+		}
+
+		case EEmpathRagdollLODState::Frozen:
+			if (TimeInState >= DeadChar->RagdollLODSnapshotDelay && DeadChar->SnapshotRagdollPose())
+			{
+				++NumSnapshot;
+			}
+			else
+			{
+				++NumFrozen;
+			}
+			break;
+
+		case EEmpathRagdollLODState::PoseSnapshot:
+			++NumSnapshot;
+			break;
+		}
+	}
+
+	// If we are over budget, freeze simulating ragdolls until we are not, regardless of whether they are at rest
+	int32 NumSimulating = SimulatingRagdolls.Num();
+	int32 const MaxSimulating = MaxSimulatingRagdolls->GetInt();
+	if (MaxSimulating >= 0 && SimulatingRagdolls.Num() > MaxSimulating)
+	{
+		SimulatingRagdolls.Sort([](FRagdollEvictionCandidate const& A, FRagdollEvictionCandidate const& B)
+		{
+			return A.EvictionScore > B.EvictionScore;
+		});
+
+		int32 const NumToEvict = SimulatingRagdolls.Num() - MaxSimulating;
+		int32 NumEvicted = 0;
+		for (int32 Idx = 0; Idx < NumToEvict; ++Idx)
+		{
+			if (SimulatingRagdolls[Idx].Character->FreezeRagdoll())
+			{
+				++NumEvicted;
+			}
+		}
+		NumSimulating -= NumEvicted;
+		NumFrozen += NumEvicted;
+	}
+
+	SET_DWORD_STAT(STAT_EMPATH_SimulatingRagdolls, NumSimulating);
+	SET_DWORD_STAT(STAT_EMPATH_FrozenRagdolls, NumFrozen);
+	SET_DWORD_STAT(STAT_EMPATH_SnapshotRagdolls, NumSnapshot);
+}
+
+AEmpathCharacter* AEmpathAIManager::SpawnPooledCharacter(TSubclassOf<AEmpathCharacter> CharacterClass, FTransform const& SpawnTransform)
+{
+	// Track how long it takes to complete this function for the profiler
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_SpawnPooledCharacter);
+
+	if (!CharacterClass)
+	{
+		return nullptr;
+	}
+
+	// Look for an inactive character of the same class
+	for (int32 Idx = PooledCharacters.Num() - 1; Idx >= 0; --Idx)
+	{
+		AEmpathCharacter* const PooledChar = PooledCharacters[Idx];
+		if (PooledChar == nullptr || PooledChar->IsPendingKill())
+		{
+			PooledCharacters.RemoveAtSwap(Idx, 1, false);
+			continue;
+		}
+
+		if (PooledChar->GetClass() == CharacterClass)
+		{
+			PooledCharacters.RemoveAtSwap(Idx, 1, false);
+			INC_DWORD_STAT(STAT_EMPATH_CharacterPoolHits);
+			SET_DWORD_STAT(STAT_EMPATH_PooledCharacters, PooledCharacters.Num());
+
+			PooledChar->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+			PooledChar->ResetFromPool();
+			AEmpathAIController* const PooledAICon = PooledChar->GetEmpathAICon();
+			if (PooledAICon)
+			{
+				PooledAICon->ResetFromPool();
+			}
+			return PooledChar;
+		}
+	}
+
+	// Nothing to reuse, so spawn a fresh one
+	INC_DWORD_STAT(STAT_EMPATH_CharacterPoolMisses);
+	return SpawnNewPooledCharacter(CharacterClass, SpawnTransform);
+}
+
+bool AEmpathAIManager::ReleaseCharacterToPool(AEmpathCharacter* Character)
+{
+	if (Character == nullptr || Character->IsPendingKill() || PooledCharacters.Contains(Character))
+	{
+		return false;
+	}
+
+	// Only keep as many characters as we are allowed
+	if (GetNumPooledCharacters(Character->GetClass()) >= CharacterPoolMaxPerClass->GetInt())
+	{
+		return false;
+	}
+
+	AEmpathAIController* const AICon = Character->GetEmpathAICon();
+	if (AICon)
+	{
+		AICon->OnReturnedToPool();
+	}
+	Character->OnReturnedToPool();
+	PooledCharacters.Add(Character);
+	SET_DWORD_STAT(STAT_EMPATH_PooledCharacters, PooledCharacters.Num());
+	return true;
+}
+
+void AEmpathAIManager::PrewarmCharacterPool(TSubclassOf<AEmpathCharacter> CharacterClass, int32 Count)
+{
+	if (!CharacterClass)
+	{
+		return;
+	}
+
+	int32 const NumToSpawn = FMath::Min(Count, CharacterPoolMaxPerClass->GetInt()) - GetNumPooledCharacters(CharacterClass);
+	for (int32 Idx = 0; Idx < NumToSpawn; ++Idx)
+	{
+		AEmpathCharacter* const NewChar = SpawnNewPooledCharacter(CharacterClass, GetActorTransform());
+		if (!NewChar || !ReleaseCharacterToPool(NewChar))
+		{
+			UE_LOG(LogAIManager, Warning, TEXT("%s: ERROR: Failed to prewarm character pool for %s!"), *GetNameSafe(this), *GetNameSafe(CharacterClass));
+			return;
+		}
+	}
+}
+
+int32 AEmpathAIManager::GetNumPooledCharacters(TSubclassOf<AEmpathCharacter> CharacterClass) const
+{
+	int32 NumPooled = 0;
+	for (AEmpathCharacter const* PooledChar : PooledCharacters)
+	{
+		if (PooledChar && PooledChar->GetClass() == CharacterClass)
+		{
+			++NumPooled;
+		}
+	}
+	return NumPooled;
+}
+
+AEmpathCharacter* AEmpathAIManager::SpawnNewPooledCharacter(TSubclassOf<AEmpathCharacter> CharacterClass, FTransform const& SpawnTransform)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	AEmpathCharacter* const NewChar = GetWorld()->SpawnActor<AEmpathCharacter>(CharacterClass, SpawnTransform, SpawnParams);
+	if (NewChar)
+	{
+		NewChar->bManagedByCharacterPool = true;
+
+		// Characters only auto possess when placed in the world by default, so make sure we have our AI controller
+		if (NewChar->GetController() == nullptr)
+		{
+			NewChar->SpawnDefaultController();
+		}
+	}
+	return NewChar;
+}
+
+bool AEmpathAIManager::GetQueryContextPlayerLocation(FVector& OutLocation)
+{
+	if (QueryContextPlayerLocationFrame == GFrameCounter)
+	{
+		INC_DWORD_STAT(STAT_EMPATH_QueryContextCacheHits);
+		OutLocation = QueryContextPlayerLocation;
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_EMPATH_QueryContextCacheMisses);
+	APlayerController* const PlayerCon = GetWorld()->GetFirstPlayerController();
+	if (PlayerCon)
+	{
+		APawn* const PlayerPawn = PlayerCon->GetPawn();
+		if (PlayerPawn)
+		{
+			AEmpathPlayerCharacter* const VRChar = Cast<AEmpathPlayerCharacter>(PlayerPawn);
+			QueryContextPlayerLocation = VRChar ? VRChar->GetVRLocation() : PlayerPawn->GetActorLocation();
+			QueryContextPlayerLocationFrame = GFrameCounter;
+			OutLocation = QueryContextPlayerLocation;
+			return true;
+		}
+	}
+	return false;
+}
+
+void AEmpathAIManager::InvalidateQueryContextCache()
+{
+	QueryContextPlayerLocationFrame = MAX_uint64;
+}
+
+void AEmpathAIManager::RequestNavRecoveryQuery(AEmpathCharacter* Character)
+{
+	if (Character)
+	{
+		NavRecoveryQueue.AddUnique(Character);
+	}
+}
+
+void AEmpathAIManager::CancelNavRecoveryQuery(AEmpathCharacter* Character)
+{
+	NavRecoveryQueue.RemoveSwap(Character);
+}
+
+void AEmpathAIManager::UpdateNavRecoveryQueries()
+{
+	// Track how long it takes to complete this function for the profiler
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_NavRecoveryScheduling);
+
+	// Remove any stale requests
+	for (int32 Idx = NavRecoveryQueue.Num() - 1; Idx >= 0; --Idx)
+	{
+		AEmpathCharacter* const QueuedChar = NavRecoveryQueue[Idx];
+		if (QueuedChar == nullptr || QueuedChar->IsPendingKill() || !QueuedChar->IsNavRecoveryQueryPending())
+		{
+			NavRecoveryQueue.RemoveAtSwap(Idx, 1, false);
+		}
+	}
+	SET_DWORD_STAT(STAT_EMPATH_NavRecoveryQueued, NavRecoveryQueue.Num());
+	if (NavRecoveryQueue.Num() == 0)
+	{
+		return;
+	}
+
+	// If we are over budget, serve the characters nearest the player first
+	int32 const Budget = NavRecoveryQueriesPerFrame->GetInt();
+	int32 const NumToStart = (Budget > 0 ? FMath::Min(Budget, NavRecoveryQueue.Num()) : NavRecoveryQueue.Num());
+	FVector PlayerLocation;
+	if (NumToStart < NavRecoveryQueue.Num() && GetQueryContextPlayerLocation(PlayerLocation))
+	{
+		NavRecoveryQueue.Sort([PlayerLocation](AEmpathCharacter const& A, AEmpathCharacter const& B)
+		{
+			return FVector::DistSquared(A.GetActorLocation(), PlayerLocation) < FVector::DistSquared(B.GetActorLocation(), PlayerLocation);
+		});
+	}
+
+	// Pull the requests out of the queue before starting them, since they may complete immediately and requeue
+	TArray<AEmpathCharacter*, TInlineAllocator<16>> CharsToStart;
+	CharsToStart.Append(NavRecoveryQueue.GetData(), NumToStart);
+	NavRecoveryQueue.RemoveAt(0, NumToStart, false);
+	for (AEmpathCharacter* const QueuedChar : CharsToStart)
+	{
+		QueuedChar->StartNavRecoveryQuery();
+	}
+	SET_DWORD_STAT(STAT_EMPATH_NavRecoveryStarted, NumToStart);
+}
@@ -1,12 +1,16 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathCharacter.h"
+#include "Empath.h"
 #include "EmpathPlayerCharacter.h"
 #include "EmpathAIController.h"
 #include "EmpathDamageType.h"
 #include "EmpathFunctionLibrary.h"
 #include "EmpathAIManager.h"
 #include "PhysicsEngine/PhysicalAnimationComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+#include "PhysicsEngine/PhysicsConstraintTemplate.h"
 #include "EmpathCharacterMovementComponent.h"
 #include "EmpathPathFollowingComponent.h"
 #include "DrawDebugHelpers.h"
@@ -14,8 +18,14 @@
 #include "AI/Navigation/NavigationData.h"
 
 // Stats for UE Profiler
-DECLARE_CYCLE_STAT(TEXT("Empath Char Take Damage"), STAT_EMPATH_TakeDamage, STATGROUP_EMPATH_Character);
-DECLARE_CYCLE_STAT(TEXT("Empath Is Ragdoll At Rest Check"), STAT_EMPATH_IsRagdollAtRest, STATGROUP_EMPATH_Character);
+DECLARE_CYCLE_STAT(TEXT("Empath Char Take Damage"), STAT_EMPATH_TakeDamage, STATGROUP_EMPATH);
+DECLARE_CYCLE_STAT(TEXT("Empath Is Ragdoll At Rest Check"), STAT_EMPATH_IsRagdollAtRest, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Char Take Damage Calls"), STAT_EMPATH_TakeDamageCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Is Ragdoll At Rest Calls"), STAT_EMPATH_IsRagdollAtRestCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Ragdoll Bodies Checked"), STAT_EMPATH_RagdollBodiesChecked, STATGROUP_EMPATH);
+DECLARE_CYCLE_STAT(TEXT("Empath Char Set Physics State"), STAT_EMPATH_SetPhysicsState, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Char Physics State Full Applies"), STAT_EMPATH_PhysicsStateFullApplies, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Char Physics State Bodies Updated"), STAT_EMPATH_PhysicsStateBodiesUpdated, STATGROUP_EMPATH);
 
 // Log categories
 DEFINE_LOG_CATEGORY_STATIC(LogNavRecovery, Log, All);
@@ -88,6 +98,17 @@ AEmpathCharacter::AEmpathCharacter(const FObjectInitializer& ObjectInitializer)
 	// Physics
 	bAllowRagdoll = true;
 	CurrentCharacterPhysicsState = EEmpathCharacterPhysicsState::Kinematic;
+	bPhysicsStateBodiesInSync = false;
+
+	// Ragdoll LOD
+	bUseRagdollLOD = true;
+	RagdollLODFreezeDistance = 1500.0f;
+	RagdollLODOffscreenTime = 1.0f;
+	RagdollLODSnapshotDelay = 5.0f;
+	RagdollLODState = EEmpathRagdollLODState::Simulating;
+
+	// Pooling
+	bManagedByCharacterPool = false;
 	
 	// Initialize default physics state entries
 	// Physical animation profiles will have to be set in blueprint
@@ -129,6 +150,8 @@ AEmpathCharacter::AEmpathCharacter(const FObjectInitializer& ObjectInitializer)
 	NavRecoverySettingsOnIsland.SearchRadiusGrowthRateInner = 25.0f;
 	NavRecoverySettingsOnIsland.SearchRadiusGrowthRateOuter = 50.0f;
 	NavRecoveryTestExtent = FVector(0.0f, 0.0f, 2048.0f);
+	bNavRecoveryQueryPending = false;
+	NavRecoveryPathQueryID = INVALID_NAVQUERYID;
 	
 	// Setup components
 	// Mesh
@@ -164,6 +187,12 @@ void AEmpathCharacter::BeginPlay()
 		PhysicalAnimation->SetSkeletalMeshComponent(GetMesh());
 	}
 
+	// Recreating the mesh's physics state resets its bodies without changing the physics asset, so we need to know when it happens
+	if (GetMesh())
+	{
+		GetMesh()->RegisterOnPhysicsCreatedDelegate(FOnSkelMeshPhysicsCreated::CreateUObject(this, &AEmpathCharacter::OnMeshPhysicsCreated));
+	}
+
 	// Set up Physics settings map for faster lookups
 	for (FEmpathCharPhysicsStateSettingsEntry const& Entry : PhysicsSettingsEntries)
 	{
@@ -173,6 +202,13 @@ void AEmpathCharacter::BeginPlay()
 
 void AEmpathCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Ensure we are removed from the ragdoll LOD
+	AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+	if (AIManager)
+	{
+		AIManager->UnregisterDeadRagdoll(this);
+	}
+
 	// Ensure we signal our destruction to the Empath AI con if we have not already
 	if (!bDead)
 	{
@@ -288,6 +324,18 @@ void AEmpathCharacter::ReceiveDie_Implementation(FHitResult const& KillingHitInf
 				FVector const Impulse = KillingHitImpulseDir * DeathImpulse + FVector(0, 0, EmpathDamageTypeCDO->DeathImpulseUpkick);
 				UEmpathFunctionLibrary::AddDistributedImpulseAtLocation(MyMesh, Impulse, KillingHitInfo.ImpactPoint, KillingHitInfo.BoneName, 0.5f);
 			}
+
+			// Hand our corpse over to the ragdoll LOD so it does not simulate for longer than it needs to
+			if (bUseRagdollLOD && MyMesh->IsSimulatingPhysics())
+			{
+				AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+				if (AIManager)
+				{
+					RagdollLODState = EEmpathRagdollLODState::Simulating;
+					RagdollLODStateStartTime = GetWorld()->GetTimeSeconds();
+					AIManager->RegisterDeadRagdoll(this);
+				}
+			}
 		}
 	}
 }
@@ -295,6 +343,16 @@ void AEmpathCharacter::ReceiveDie_Implementation(FHitResult const& KillingHitInf
 void AEmpathCharacter::CleanUpPostDeath_Implementation()
 {
 	GetWorldTimerManager().ClearTimer(CleanUpPostDeathTimerHandle);
+
+	// Return to the character pool rather than being destroyed if possible
+	if (bManagedByCharacterPool)
+	{
+		AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+		if (AIManager && AIManager->ReleaseCharacterToPool(this))
+		{
+			return;
+		}
+	}
 	SetLifeSpan(0.001f);
 }
 
@@ -374,6 +432,7 @@ float AEmpathCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Damag
 {
 	// Scope these functions for the UE4 profiler
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_TakeDamage);
+	INC_DWORD_STAT(STAT_EMPATH_TakeDamageCalls);
 
 	// If we're invincible, dead, or this is no damage, do nothing
 	if (bInvincible || bDead || DamageAmount <= 0.0f)
@@ -637,82 +696,362 @@ void AEmpathCharacter::TakeStunDamage(const float StunDamageAmount, const AContr
 
 bool AEmpathCharacter::SetCharacterPhysicsState(EEmpathCharacterPhysicsState NewState)
 {
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_SetPhysicsState);
+
 	if (NewState != CurrentCharacterPhysicsState)
 	{
 		// Notify state end
 		ReceiveEndCharacterPhysicsState(CurrentCharacterPhysicsState);
 
-		FEmpathCharPhysicsStateSettings NewSettings;
-
 		// Look up new state settings
+		FEmpathCharPhysicsStateSettings const* const NewSettings = PhysicsStateToSettingsMap.Find(NewState);
+		if (!NewSettings)
+		{
+			// Log error. The enum only needs to be found once
+			static UEnum const* const PhysicsStateEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EEmpathCharacterPhysicsState"), true);
+			FName const EnumName = PhysicsStateEnum ? PhysicsStateEnum->GetNameByValue((int64)NewState) : FName(TEXT("Invalid Entry"));
+			UE_LOG(LogTemp, Warning, TEXT("%s ERROR: Could not find new physics state settings %s!"), *GetName(), *EnumName.ToString());
+			return false;
+		}
+
+		// If our bodies still match the current state, we only need to apply what differs in the new one.
+		// Otherwise, reapply everything so that we are back in sync
+		bool bCanApplyTransition = false;
+		if (ResolvePhysicsStates() && bPhysicsStateBodiesInSync)
+		{
+			FEmpathPhysicsStateTransition const& Transition = PhysicsStateTransitions[((int32)CurrentCharacterPhysicsState * ResolvedPhysicsStates.Num()) + (int32)NewState];
+			bCanApplyTransition = (Transition.SimulateBodies.Num() == 0 || Transition.SimulateRootBoneName != NAME_None);
+		}
+
+		if (bCanApplyTransition)
+		{
+			ApplyPhysicsStateTransition(CurrentCharacterPhysicsState, NewState);
+		}
+		else
+		{
+			ApplyPhysicsStateSettingsFull(*NewSettings);
+			bPhysicsStateBodiesInSync = ResolvePhysicsStates();
+		}
+
+		// Update state and signal notifies
+		CurrentCharacterPhysicsState = NewState;
+		ReceiveBeginCharacterPhysicsState(NewState);
+	}
+
+	return true;
+}
+
+void AEmpathCharacter::ReapplyCharacterPhysicsState()
+{
+	FEmpathCharPhysicsStateSettings const* const CurrentSettings = PhysicsStateToSettingsMap.Find(CurrentCharacterPhysicsState);
+	if (CurrentSettings)
+	{
+		ApplyPhysicsStateSettingsFull(*CurrentSettings);
+		bPhysicsStateBodiesInSync = ResolvePhysicsStates();
+	}
+	else
+	{
+		bPhysicsStateBodiesInSync = false;
+	}
+}
+
+void AEmpathCharacter::OnMeshPhysicsCreated()
+{
+	bPhysicsStateBodiesInSync = false;
+}
+
+void AEmpathCharacter::ApplyPhysicsStateSettingsFull(FEmpathCharPhysicsStateSettings const& NewSettings)
+{
+	INC_DWORD_STAT(STAT_EMPATH_PhysicsStateFullApplies);
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+
+	// Set simulate physics
+	if (NewSettings.bSimulatePhysics == false)
+	{
+		MyMesh->SetSimulatePhysics(false);
+	}
+	else
+	{
+		if (NewSettings.SimulatePhysicsBodyBelowName != NAME_None)
+		{
+			// We need to set false first since the SetAllBodiesBelow call below doesn't affect bodies above.
+			// so we want to ensure they are in the default state
+			MyMesh->SetSimulatePhysics(false);
+			MyMesh->SetAllBodiesBelowSimulatePhysics(NewSettings.SimulatePhysicsBodyBelowName, true, true);
+		}
+		else
 		{
-			FEmpathCharPhysicsStateSettings* FoundNewSettings = PhysicsStateToSettingsMap.Find(NewState);
-			if (FoundNewSettings)
+			MyMesh->SetSimulatePhysics(true);
+		}
+	}
+
+	// Set gravity
+	MyMesh->SetEnableGravity(NewSettings.bEnableGravity);
+
+	// Set physical animation
+	PhysicalAnimation->ApplyPhysicalAnimationProfileBelow(NewSettings.PhysicalAnimationBodyName, NewSettings.PhysicalAnimationProfileName, true, true);
+
+	// Set constraint profile
+	if (NewSettings.ConstraintProfileJointName == NAME_None)
+	{
+		MyMesh->SetConstraintProfileForAll(NewSettings.ConstraintProfileName, true);
+	}
+	else
+	{
+		MyMesh->SetConstraintProfile(NewSettings.ConstraintProfileJointName, NewSettings.ConstraintProfileName, true);
+	}
+}
+
+bool AEmpathCharacter::ResolvePhysicsStates()
+{
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+	UPhysicsAsset* const PhysAsset = MyMesh ? MyMesh->GetPhysicsAsset() : nullptr;
+	if (!PhysAsset || !MyMesh->SkeletalMesh || !PhysicalAnimation
+		|| MyMesh->Bodies.Num() == 0
+		|| MyMesh->Bodies.Num() != PhysAsset->SkeletalBodySetups.Num()
+		|| MyMesh->Constraints.Num() != PhysAsset->ConstraintSetup.Num()
+		|| (!MyMesh->bEnablePhysicsOnDedicatedServer && IsRunningDedicatedServer()))
+	{
+		ResolvedPhysicsAsset = nullptr;
+		ResolvedPhysicsStates.Empty();
+		PhysicsStateTransitions.Empty();
+		return false;
+	}
+
+	// Only resolve again if our physics asset changes
+	if (ResolvedPhysicsAsset.Get() == PhysAsset && ResolvedPhysicsStates.Num() > 0)
+	{
+		return true;
+	}
+
+	int32 const NumBodies = PhysAsset->SkeletalBodySetups.Num();
+	int32 const NumConstraints = PhysAsset->ConstraintSetup.Num();
+
+	// Size the table to cover every state we have settings for, as well as our current one
+	int32 NumStates = (int32)CurrentCharacterPhysicsState + 1;
+	for (TPair<EEmpathCharacterPhysicsState, FEmpathCharPhysicsStateSettings> const& SettingsPair : PhysicsStateToSettingsMap)
+	{
+		NumStates = FMath::Max(NumStates, (int32)SettingsPair.Key + 1);
+	}
+
+	// Resolve what each state does to each body and constraint, mirroring ApplyPhysicsStateSettingsFull
+	ResolvedPhysicsStates.Reset();
+	ResolvedPhysicsStates.SetNum(NumStates);
+	TArray<int32> BodiesBelow;
+	for (int32 StateIdx = 0; StateIdx < NumStates; ++StateIdx)
+	{
+		FEmpathResolvedPhysicsState& Resolved = ResolvedPhysicsStates[StateIdx];
+		FEmpathCharPhysicsStateSettings const* const Settings = PhysicsStateToSettingsMap.Find((EEmpathCharacterPhysicsState)StateIdx);
+		if (!Settings)
+		{
+			continue;
+		}
+		Resolved.bHasSettings = true;
+		Resolved.Settings = *Settings;
+
+		// Simulate physics. Setting the whole mesh only affects bodies using the default physics type,
+		// while setting the bodies below a bone affects every type
+		Resolved.BodySimulate.SetNumUninitialized(NumBodies);
+		for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+		{
+			UBodySetup const* const BodySetup = PhysAsset->SkeletalBodySetups[BodyIdx];
+			bool const bDefaultType = BodySetup && BodySetup->PhysicsType == PhysType_Default;
+			Resolved.BodySimulate[BodyIdx] = bDefaultType ? (Settings->bSimulatePhysics && Settings->SimulatePhysicsBodyBelowName == NAME_None) : -1;
+		}
+		if (Settings->bSimulatePhysics && Settings->SimulatePhysicsBodyBelowName != NAME_None)
+		{
+			BodiesBelow.Reset();
+			PhysAsset->GetBodyIndicesBelow(BodiesBelow, Settings->SimulatePhysicsBodyBelowName, MyMesh->SkeletalMesh, true);
+			for (int32 BodyIdx : BodiesBelow)
 			{
-				NewSettings = *FoundNewSettings;
+				Resolved.BodySimulate[BodyIdx] = 1;
 			}
-			else
+		}
+
+		// Gravity can't be turned on for bodies that have it off in the physics asset
+		Resolved.BodyGravity.SetNumUninitialized(NumBodies);
+		for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+		{
+			UBodySetup const* const BodySetup = PhysAsset->SkeletalBodySetups[BodyIdx];
+			Resolved.BodyGravity[BodyIdx] = Settings->bEnableGravity && BodySetup && BodySetup->DefaultInstance.bEnableGravity;
+		}
+
+		// Physical animation is applied to every body below the named body, or all bodies if there is no name
+		Resolved.BodyDriveProfile.Init(NAME_None, NumBodies);
+		Resolved.BodyDriveSet.Init(false, NumBodies);
+		BodiesBelow.Reset();
+		if (Settings->PhysicalAnimationBodyName == NAME_None)
+		{
+			for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
 			{
-				// Log error.
-				FName EnumName;
-				const UEnum* EnumPtr = FindObject<UEnum>(ANY_PACKAGE, TEXT("EEmpathCharacterPhysicsState"), true);
-				if (EnumPtr)
-				{
-					EnumName = EnumPtr->GetNameByValue((int64)NewState);
-				}
-				else
-				{
-					EnumName = "Invalid Entry";
-				}
-				UE_LOG(LogTemp, Warning, TEXT("%s ERROR: Could not find new physics state settings %s!"), *GetName(), *EnumName.ToString());
-				return false;
+				BodiesBelow.Add(BodyIdx);
 			}
 		}
+		else
+		{
+			PhysAsset->GetBodyIndicesBelow(BodiesBelow, Settings->PhysicalAnimationBodyName, MyMesh->SkeletalMesh, true);
+		}
+		for (int32 BodyIdx : BodiesBelow)
+		{
+			USkeletalBodySetup const* const BodySetup = Cast<USkeletalBodySetup>(PhysAsset->SkeletalBodySetups[BodyIdx]);
+			Resolved.BodyDriveSet[BodyIdx] = true;
+			Resolved.BodyDriveProfile[BodyIdx] = (BodySetup && BodySetup->FindPhysicalAnimationProfile(Settings->PhysicalAnimationProfileName)) ? Settings->PhysicalAnimationProfileName : NAME_None;
+		}
 
-		USkeletalMeshComponent* const MyMesh = GetMesh();
+		// Constraint profiles are applied to every constraint, or only those on the named joint
+		Resolved.ConstraintProfile.Init(Settings->ConstraintProfileName, NumConstraints);
+		Resolved.ConstraintProfileSet.SetNumUninitialized(NumConstraints);
+		for (int32 ConstraintIdx = 0; ConstraintIdx < NumConstraints; ++ConstraintIdx)
+		{
+			UPhysicsConstraintTemplate const* const ConstraintSetup = PhysAsset->ConstraintSetup[ConstraintIdx];
+			Resolved.ConstraintProfileSet[ConstraintIdx] = ConstraintSetup 
+				&& (Settings->ConstraintProfileJointName == NAME_None || ConstraintSetup->DefaultInstance.JointName == Settings->ConstraintProfileJointName);
+		}
+	}
 
-		// Set simulate physics
-		if (NewSettings.bSimulatePhysics == false)
+	// Cache the bodies below each body so we can find a subtree to reapply simulation through for each transition
+	TArray<TArray<int32>> BodySubtrees;
+	BodySubtrees.SetNum(NumBodies);
+	for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+	{
+		if (PhysAsset->SkeletalBodySetups[BodyIdx])
 		{
-			MyMesh->SetSimulatePhysics(false);
+			PhysAsset->GetBodyIndicesBelow(BodySubtrees[BodyIdx], PhysAsset->SkeletalBodySetups[BodyIdx]->BoneName, MyMesh->SkeletalMesh, true);
 		}
-		else
+	}
+
+	// Precompute what changes between each pair of states.
+	// Anything the old state left as it was is treated as changed, since we can't know what it was
+	PhysicsStateTransitions.Reset();
+	PhysicsStateTransitions.SetNum(NumStates * NumStates);
+	for (int32 FromIdx = 0; FromIdx < NumStates; ++FromIdx)
+	{
+		FEmpathResolvedPhysicsState const& From = ResolvedPhysicsStates[FromIdx];
+		for (int32 ToIdx = 0; ToIdx < NumStates; ++ToIdx)
 		{
-			if (NewSettings.SimulatePhysicsBodyBelowName != NAME_None)
+			FEmpathResolvedPhysicsState const& To = ResolvedPhysicsStates[ToIdx];
+			if (!From.bHasSettings || !To.bHasSettings || FromIdx == ToIdx)
 			{
-				// We need to set false first since the SetAllBodiesBelow call below doesn't affect bodies above.
-				// so we want to ensure they are in the default state
-				MyMesh->SetSimulatePhysics(false);
-				MyMesh->SetAllBodiesBelowSimulatePhysics(NewSettings.SimulatePhysicsBodyBelowName, true, true);
+				continue;
 			}
-			else
+
+			FEmpathPhysicsStateTransition& Transition = PhysicsStateTransitions[(FromIdx * NumStates) + ToIdx];
+			for (int32 BodyIdx = 0; BodyIdx < NumBodies; ++BodyIdx)
+			{
+				if (To.BodySimulate[BodyIdx] != -1 && From.BodySimulate[BodyIdx] != To.BodySimulate[BodyIdx])
+				{
+					Transition.SimulateBodies.Add(BodyIdx);
+				}
+				if (From.BodyGravity[BodyIdx] != To.BodyGravity[BodyIdx])
+				{
+					Transition.GravityBodies.Add(BodyIdx);
+				}
+				if (To.BodyDriveSet[BodyIdx] && (!From.BodyDriveSet[BodyIdx] || From.BodyDriveProfile[BodyIdx] != To.BodyDriveProfile[BodyIdx]))
+				{
+					Transition.bPhysicalAnimationChanged = true;
+				}
+			}
+			// Pick the smallest changed subtree that ends up entirely in one simulate state
+			int32 SimulateRootSubtreeSize = MAX_int32;
+			for (int32 BodyIdx : Transition.SimulateBodies)
 			{
-				MyMesh->SetSimulatePhysics(true);
+				TArray<int32> const& Subtree = BodySubtrees[BodyIdx];
+				if (Subtree.Num() > 0 && Subtree.Num() < SimulateRootSubtreeSize)
+				{
+					bool bUniformSubtree = true;
+					for (int32 SubtreeBodyIdx : Subtree)
+					{
+						if (To.BodySimulate[SubtreeBodyIdx] != To.BodySimulate[BodyIdx])
+						{
+							bUniformSubtree = false;
+							break;
+						}
+					}
+					if (bUniformSubtree)
+					{
+						SimulateRootSubtreeSize = Subtree.Num();
+						Transition.SimulateRootBoneName = PhysAsset->SkeletalBodySetups[BodyIdx]->BoneName;
+						Transition.bSimulateRootBoneValue = To.BodySimulate[BodyIdx] != 0;
+					}
+				}
+			}
+
+			for (int32 ConstraintIdx = 0; ConstraintIdx < NumConstraints; ++ConstraintIdx)
+			{
+				if (To.ConstraintProfileSet[ConstraintIdx] 
+					&& (!From.ConstraintProfileSet[ConstraintIdx] || From.ConstraintProfile[ConstraintIdx] != To.ConstraintProfile[ConstraintIdx]))
+				{
+					Transition.Constraints.Add(ConstraintIdx);
+				}
 			}
 		}
+	}
 
-		// Set gravity
-		MyMesh->SetEnableGravity(NewSettings.bEnableGravity);
+	ResolvedPhysicsAsset = PhysAsset;
 
-		// Set physical animation
-		PhysicalAnimation->ApplyPhysicalAnimationProfileBelow(NewSettings.PhysicalAnimationBodyName, NewSettings.PhysicalAnimationProfileName, true, true);
+	// Any previous sync was against the old asset
+	bPhysicsStateBodiesInSync = false;
+	return true;
+}
 
-		// Set constraint profile
-		if (NewSettings.ConstraintProfileJointName == NAME_None)
+void AEmpathCharacter::ApplyPhysicsStateTransition(EEmpathCharacterPhysicsState OldState, EEmpathCharacterPhysicsState NewState)
+{
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+	UPhysicsAsset* const PhysAsset = ResolvedPhysicsAsset.Get();
+	int32 const NumStates = ResolvedPhysicsStates.Num();
+	FEmpathResolvedPhysicsState const& Resolved = ResolvedPhysicsStates[(int32)NewState];
+	FEmpathPhysicsStateTransition const& Transition = PhysicsStateTransitions[((int32)OldState * NumStates) + (int32)NewState];
+
+	// Simulate physics. Bodies that are already in the right state are left alone,
+	// so we don't pay for toggling bodies off and back on
+	MyMesh->BodyInstance.bSimulatePhysics = Resolved.Settings.bSimulatePhysics && Resolved.Settings.SimulatePhysicsBodyBelowName == NAME_None;
+	MyMesh->bBlendPhysics = MyMesh->BodyInstance.bSimulatePhysics;
+	bool bSimulateChanged = false;
+	for (int32 BodyIdx : Transition.SimulateBodies)
+	{
+		FBodyInstance* const BI = MyMesh->Bodies[BodyIdx];
+		bool const bSimulate = Resolved.BodySimulate[BodyIdx] != 0;
+		if (BI && BI->IsInstanceSimulatingPhysics() != bSimulate)
 		{
-			MyMesh->SetConstraintProfileForAll(NewSettings.ConstraintProfileName, true);
+			BI->SetInstanceSimulatePhysics(bSimulate);
+			bSimulateChanged = true;
+			INC_DWORD_STAT(STAT_EMPATH_PhysicsStateBodiesUpdated);
 		}
-		else
+	}
+
+	// The mesh only updates its root body and physics ticks when simulation is changed through it,
+	// so reapply the smallest changed subtree through the mesh. Its bodies are already in their final state
+	if (bSimulateChanged)
+	{
+		MyMesh->SetAllBodiesBelowSimulatePhysics(Transition.SimulateRootBoneName, Transition.bSimulateRootBoneValue, true);
+	}
+
+	// Set gravity
+	MyMesh->BodyInstance.bEnableGravity = Resolved.Settings.bEnableGravity;
+	for (int32 BodyIdx : Transition.GravityBodies)
+	{
+		FBodyInstance* const BI = MyMesh->Bodies[BodyIdx];
+		if (BI)
 		{
-			MyMesh->SetConstraintProfile(NewSettings.ConstraintProfileJointName, NewSettings.ConstraintProfileName, true);
+			BI->SetEnableGravity(Resolved.BodyGravity[BodyIdx]);
 		}
+	}
 
-		// Update state and signal notifies
-		CurrentCharacterPhysicsState = NewState;
-		ReceiveBeginCharacterPhysicsState(NewState);
+	// Physical animation drives are rebuilt as a whole by the component, so only reapply them if any body's profile changes
+	if (Transition.bPhysicalAnimationChanged)
+	{
+		PhysicalAnimation->ApplyPhysicalAnimationProfileBelow(Resolved.Settings.PhysicalAnimationBodyName, Resolved.Settings.PhysicalAnimationProfileName, true, true);
 	}
 
-	return true;
+	// Set constraint profiles
+	for (int32 ConstraintIdx : Transition.Constraints)
+	{
+		FConstraintInstance* const ConstraintInstance = MyMesh->Constraints[ConstraintIdx];
+		if (ConstraintInstance)
+		{
+			PhysAsset->ConstraintSetup[ConstraintIdx]->ApplyConstraintProfile(Resolved.ConstraintProfile[ConstraintIdx], *ConstraintInstance, true);
+		}
+	}
 }
 
 bool AEmpathCharacter::CanRagdoll_Implementation()
@@ -793,6 +1132,7 @@ void AEmpathCharacter::CheckForEndRagdoll()
 bool AEmpathCharacter::IsRagdollAtRest() const
 {
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_IsRagdollAtRest);
+	INC_DWORD_STAT(STAT_EMPATH_IsRagdollAtRestCalls);
 
 	if (bRagdolling)
 	{
@@ -803,6 +1143,7 @@ bool AEmpathCharacter::IsRagdollAtRest() const
 		// Calculate the current rate of movement of our physics bodies
 		for (FBodyInstance const* BI : MyMesh->Bodies)
 		{
+			INC_DWORD_STAT(STAT_EMPATH_RagdollBodiesChecked);
 			if (BI->IsInstanceSimulatingPhysics())
 			{
 				if (BI->GetUnrealWorldTransform().GetLocation().Z < GetWorldSettings()->KillZ)
@@ -838,6 +1179,41 @@ bool AEmpathCharacter::IsRagdollAtRest() const
 	return true;
 }
 
+bool AEmpathCharacter::FreezeRagdoll()
+{
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+	if (MyMesh && bRagdolling && RagdollLODState == EEmpathRagdollLODState::Simulating)
+	{
+		// Stop updating the skeleton before we stop simulating, 
+		// so that the mesh holds the last simulated pose rather than snapping back to the animated one
+		MyMesh->bPauseAnims = true;
+		MyMesh->bNoSkeletonUpdate = true;
+		MyMesh->SetSimulatePhysics(false);
+		bPhysicsStateBodiesInSync = false;
+
+		RagdollLODState = EEmpathRagdollLODState::Frozen;
+		RagdollLODStateStartTime = GetWorld()->GetTimeSeconds();
+		return true;
+	}
+	return false;
+}
+
+bool AEmpathCharacter::SnapshotRagdollPose()
+{
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+	if (MyMesh && RagdollLODState == EEmpathRagdollLODState::Frozen)
+	{
+		// The skeleton stopped updating when we froze, so the mesh keeps its pose without the bodies or component tick
+		MyMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		MyMesh->SetComponentTickEnabled(false);
+		bPhysicsStateBodiesInSync = false;
+
+		RagdollLODState = EEmpathRagdollLODState::PoseSnapshot;
+		RagdollLODStateStartTime = GetWorld()->GetTimeSeconds();
+		return true;
+	}
+	return false;
+}
 
 void AEmpathCharacter::StartRecoverFromRagdoll()
 {
@@ -872,6 +1248,74 @@ void AEmpathCharacter::StopRagdoll(EEmpathCharacterPhysicsState NewPhysicsState)
 	}
 }
 
+void AEmpathCharacter::OnReturnedToPool()
+{
+	// Stop any pending events
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	// Ensure we are removed from the ragdoll LOD
+	AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+	if (AIManager)
+	{
+		AIManager->UnregisterDeadRagdoll(this);
+	}
+
+	// Remove ourselves from the world without destroying anything
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+}
+
+void AEmpathCharacter::ResetFromPool()
+{
+	// Health and damage
+	bDead = false;
+	CurrentHealth = MaxHealth;
+
+	// Stunning
+	bStunned = false;
+	LastStunTime = 0.0f;
+	StunDamageHistory.Empty();
+
+	// Nav recovery
+	ClearNavRecoveryState();
+
+	// Physics
+	USkeletalMeshComponent* const MyMesh = GetMesh();
+	MyMesh->bPauseAnims = false;
+	MyMesh->bNoSkeletonUpdate = false;
+	MyMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	MyMesh->SetComponentTickEnabled(true);
+	RagdollLODState = EEmpathRagdollLODState::Simulating;
+	bDeferredGetUpFromRagdoll = false;
+
+	// Our bodies could have been changed any number of ways while we were pooled, so always apply the physics state in full
+	bPhysicsStateBodiesInSync = false;
+	StopRagdoll(EEmpathCharacterPhysicsState::Kinematic);
+	if (CurrentCharacterPhysicsState != EEmpathCharacterPhysicsState::Kinematic)
+	{
+		SetCharacterPhysicsState(EEmpathCharacterPhysicsState::Kinematic);
+	}
+	else if (!bPhysicsStateBodiesInSync)
+	{
+		ReapplyCharacterPhysicsState();
+	}
+
+	// Restore the mesh to where it sits on the capsule in a freshly spawned character
+	MyMesh->SetRelativeLocationAndRotation(GetBaseTranslationOffset(), GetBaseRotationOffset());
+
+	// Return to the world
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	ReceiveResetFromPool();
+}
+
 FVector AEmpathCharacter::GetPathingSourceLocation() const
 {
 	FVector AgentLocation = FNavigationSystem::InvalidLocation;
@@ -1189,6 +1633,7 @@ void AEmpathCharacter::ClearNavRecoveryState()
 	NavFailureCurrentCount = 0;
 	NavFailureFirstFailTime = 0.f;
 	NavRecoveryCounter = 0;
+	CancelNavRecoveryQuery();
 
 	AEmpathAIController* const AI = GetEmpathAICon();
 	if (AI)
@@ -1295,52 +1740,141 @@ void AEmpathCharacter::OnTickNavMeshRecovery(FEmpathNavRecoverySettings const& C
 	ensure(IsFailingNavigation());
 	ensure(!RecoveryDestination.IsZero());
 
-	// Try automatic recovery methods if requested.
-	bool bRecovered = false;
+	// Queue up a check for whether we have recovered. 
+	// The AI Manager runs these under a shared budget, so the result may arrive on a later frame.
+	if (!bNavRecoveryQueryPending)
+	{
+		bNavRecoveryQueryPending = true;
+		AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+		if (AIManager)
+		{
+			AIManager->RequestNavRecoveryQuery(this);
+		}
+		else
+		{
+			StartNavRecoveryQuery();
+		}
+
+		// We may have recovered immediately
+		if (!IsFailingNavigation())
+		{
+			return;
+		}
+	}
+
+	// Try automatic recovery methods while we wait
+	if (CurrentSettings.NavRecoverySkipFrames <= 0 || (NavRecoveryCounter % (CurrentSettings.NavRecoverySkipFrames + 1)) == 0)
+	{
+		UE_LOG(LogNavRecovery, VeryVerbose, TEXT("%s: Tick recovery from location [%s] -> [%s] (dist=%.2f, dist2D=%.2f) StartedOnMesh=%d"),
+			*GetNameSafe(this), *Location.ToString(), *RecoveryDestination.ToString(), (Location - RecoveryDestination).Size(), (Location - RecoveryDestination).Size2D(), bFailedNavigationStartedOnNavMesh);
+		NAVRECOVERY_LOC(Location, GetCapsuleComponent()->GetScaledCapsuleRadius(), FColor::Cyan);
+		NAVRECOVERY_LOC(RecoveryDestination, GetCapsuleComponent()->GetScaledCapsuleRadius(), FColor::Cyan);
+		NAVRECOVERY_LINE(Location, RecoveryDestination, FColor::Cyan);
+
+		ReceiveTickNavMeshRecovery(DeltaTime, Location, RecoveryDestination);
+	}
+	else
+	{
+		UE_LOG(LogNavRecovery, VeryVerbose, TEXT("%s: Skipped recovery from location [%s] -> [%s] (dist=%.2f, dist2D=%.2f) StartedOnMesh=%d"),
+			*GetNameSafe(this), *Location.ToString(), *RecoveryDestination.ToString(), (Location - RecoveryDestination).Size(), (Location - RecoveryDestination).Size2D(), bFailedNavigationStartedOnNavMesh);
+	}
+	NavRecoveryCounter++;
+}
+
+void AEmpathCharacter::StartNavRecoveryQuery()
+{
+	if (!IsFailingNavigation() || bDead)
+	{
+		bNavRecoveryQueryPending = false;
+		return;
+	}
 
-	FVector ProjectedPoint = FVector::ZeroVector;
 	if ((NavRecoveryAbility == EEmpathNavRecoveryAbility::OffNavMesh) || (IsFailingNavigationFromValidNavMesh() == false))
 	{
 		// Can only recover from off nav mesh, or we started off navmesh so just want to get there.
-		bRecovered = UEmpathFunctionLibrary::EmpathProjectPointToNavigation(this, ProjectedPoint, Location, nullptr, nullptr, NavRecoveryTestExtent);
+		// Projection is cheap compared to pathfinding, so do it right away.
+		FVector ProjectedPoint = FVector::ZeroVector;
+		bool const bRecovered = UEmpathFunctionLibrary::EmpathProjectPointToNavigation(this, ProjectedPoint, GetActorLocation(), nullptr, nullptr, NavRecoveryTestExtent);
+		OnNavRecoveryQueryComplete(bRecovered, ProjectedPoint);
 	}
 	else if (NavRecoveryAbility == EEmpathNavRecoveryAbility::OnNavMeshIsland)
 	{
 		// Recovered if we can now path to the desired goal location (that was off the island).
-		ProjectedPoint = GetPathingSourceLocation();
-		bRecovered = UEmpathFunctionLibrary::EmpathHasPathToLocation(this, RecoveryDestination);
+		UNavigationSystem* const NavSys = UNavigationSystem::GetCurrent(GetWorld());
+		ANavigationData* const NavData = (NavSys ? NavSys->GetNavDataForProps(GetNavAgentPropertiesRef()) : nullptr);
+		if (NavData)
+		{
+			TSubclassOf<UNavigationQueryFilter> FilterClass = nullptr;
+			if (AAIController* AI = Cast<AAIController>(GetController()))
+			{
+				FilterClass = AI->GetDefaultNavigationFilterClass();
+			}
+
+			FPathFindingQuery Query(*this, *NavData, GetPathingSourceLocation(), GetNavRecoveryDestination(), UNavigationQueryFilter::GetQueryFilter(*NavData, this, FilterClass));
+			Query.SetAllowPartialPaths(false);
+			NavRecoveryPathQueryID = NavSys->FindPathAsync(GetNavAgentPropertiesRef(), Query,
+				FNavPathQueryDelegate::CreateUObject(this, &AEmpathCharacter::OnNavRecoveryPathQueryComplete), EPathFindingMode::Regular);
+		}
+		else
+		{
+			OnNavRecoveryQueryComplete(false, FVector::ZeroVector);
+		}
 	}
 	else
 	{
 		// Do nothing.
+		bNavRecoveryQueryPending = false;
+	}
+}
+
+void AEmpathCharacter::OnNavRecoveryPathQueryComplete(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	// Ignore results for queries we have since cancelled
+	if (QueryID != NavRecoveryPathQueryID)
+	{
+		return;
 	}
+	NavRecoveryPathQueryID = INVALID_NAVQUERYID;
+
+	bool const bRecovered = (Result == ENavigationQueryResult::Success && Path.IsValid() && !Path->IsPartial());
+	OnNavRecoveryQueryComplete(bRecovered, GetPathingSourceLocation());
+}
+
+void AEmpathCharacter::OnNavRecoveryQueryComplete(bool bRecovered, FVector ProjectedPoint)
+{
+	bNavRecoveryQueryPending = false;
 
 	// See if we recovered.
-	if (bRecovered)
+	if (bRecovered && IsFailingNavigation() && !bDead)
 	{
+		FVector const RecoveryDestination = GetNavRecoveryDestination();
 		NAVRECOVERY_LOC_DURATION(ProjectedPoint, GetCapsuleComponent()->GetScaledCapsuleRadius() * 0.85f, FColor::Green);
 		NAVRECOVERY_LOC_DURATION(RecoveryDestination, GetCapsuleComponent()->GetScaledCapsuleRadius() * 0.85f, FColor::Green);
 		NAVRECOVERY_LINE_DURATION(ProjectedPoint, RecoveryDestination, FColor::Green);
 		OnNavMeshRecovered();
 	}
-	else
+}
+
+void AEmpathCharacter::CancelNavRecoveryQuery()
+{
+	if (bNavRecoveryQueryPending)
 	{
-		if (CurrentSettings.NavRecoverySkipFrames <= 0 || (NavRecoveryCounter % (CurrentSettings.NavRecoverySkipFrames + 1)) == 0)
+		bNavRecoveryQueryPending = false;
+		AEmpathAIManager* const AIManager = UEmpathFunctionLibrary::GetAIManager(this);
+		if (AIManager)
 		{
-			UE_LOG(LogNavRecovery, VeryVerbose, TEXT("%s: Tick recovery from location [%s] -> [%s] (dist=%.2f, dist2D=%.2f) StartedOnMesh=%d"),
-				*GetNameSafe(this), *Location.ToString(), *RecoveryDestination.ToString(), (Location - RecoveryDestination).Size(), (Location - RecoveryDestination).Size2D(), bFailedNavigationStartedOnNavMesh);
-			NAVRECOVERY_LOC(Location, GetCapsuleComponent()->GetScaledCapsuleRadius(), FColor::Cyan);
-			NAVRECOVERY_LOC(RecoveryDestination, GetCapsuleComponent()->GetScaledCapsuleRadius(), FColor::Cyan);
-			NAVRECOVERY_LINE(Location, RecoveryDestination, FColor::Cyan);
-
-			ReceiveTickNavMeshRecovery(DeltaTime, Location, RecoveryDestination);
+			AIManager->CancelNavRecoveryQuery(this);
 		}
-		else
+	}
+
+	if (NavRecoveryPathQueryID != INVALID_NAVQUERYID)
+	{
+		UNavigationSystem* const NavSys = UNavigationSystem::GetCurrent(GetWorld());
+		if (NavSys)
 		{
-			UE_LOG(LogNavRecovery, VeryVerbose, TEXT("%s: Skipped recovery from location [%s] -> [%s] (dist=%.2f, dist2D=%.2f) StartedOnMesh=%d"),
-				*GetNameSafe(this), *Location.ToString(), *RecoveryDestination.ToString(), (Location - RecoveryDestination).Size(), (Location - RecoveryDestination).Size2D(), bFailedNavigationStartedOnNavMesh);
+			NavSys->AbortAsyncFindPathRequest(NavRecoveryPathQueryID);
 		}
-		NavRecoveryCounter++;
+		NavRecoveryPathQueryID = INVALID_NAVQUERYID;
 	}
 }
 
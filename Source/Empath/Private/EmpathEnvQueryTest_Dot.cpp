@@ -1,6 +1,7 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathEnvQueryTest_Dot.h"
+#include "Empath.h"
 #include "EnvironmentQuery/Tests/EnvQueryTest_Dot.h"
 #include "EnvironmentQuery/Items/EnvQueryItemType_VectorBase.h"
 #include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
@@ -9,6 +10,22 @@
 #include "EmpathAIController.h"
 #include "EmpathPlayerCharacter.h"
 
+// Stats for UE Profiler
+DECLARE_CYCLE_STAT(TEXT("EQS Test Empath Dot"), STAT_EMPATH_EQSTestDot, STATGROUP_EMPATH);
+DECLARE_CYCLE_STAT(TEXT("EQS Test Empath Dot Batched"), STAT_EMPATH_EQSTestDotBatched, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Test Empath Dot Calls"), STAT_EMPATH_EQSTestDotCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Test Empath Dot Items"), STAT_EMPATH_EQSTestDotItems, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("EQS Test Empath Dot Scratch Bytes"), STAT_EMPATH_EQSTestDotScratchBytes, STATGROUP_EMPATH);
+
+// Console variable setup so we can compare the batched and per item scoring paths
+static TAutoConsoleVariable<int32> CVarEmpathEQSDotBatched(
+	TEXT("Empath.EQSDotBatched"),
+	1,
+	TEXT("Whether the Empath dot test scores items in a single batch when possible.\n")
+	TEXT("0: Always score per item, 1: Batch when possible"),
+	ECVF_Default);
+static const auto EQSDotBatched = IConsoleManager::Get().FindConsoleVariable(TEXT("Empath.EQSDotBatched"));
+
 UEmpathEnvQueryTest_Dot::UEmpathEnvQueryTest_Dot(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Cost = EEnvTestCost::Low;
@@ -26,6 +43,10 @@ UEmpathEnvQueryTest_Dot::UEmpathEnvQueryTest_Dot(const FObjectInitializer& Objec
 
 void UEmpathEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_EQSTestDot);
+	INC_DWORD_STAT(STAT_EMPATH_EQSTestDotCalls);
+	INC_DWORD_STAT_BY(STAT_EMPATH_EQSTestDotItems, QueryInstance.Items.Num());
+
 	UObject* QueryOwner = QueryInstance.Owner.Get();
 	if (QueryOwner == nullptr)
 	{
@@ -61,6 +82,13 @@ void UEmpathEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 		}
 	}
 
+	// Score all items in one batch unless we need per item rotations
+	if (CanRunBatched(bUpdateLineAPerItem, bUpdateLineBPerItem))
+	{
+		RunTestBatched(QueryInstance, LineADirs, LineBDirs, bUpdateLineAPerItem, bUpdateLineBPerItem, MinThresholdValue, MaxThresholdValue);
+		return;
+	}
+
 	// loop through all items
 	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
 	{
@@ -114,6 +142,208 @@ void UEmpathEnvQueryTest_Dot::RunTest(FEnvQueryInstance& QueryInstance) const
 	}
 }
 
+bool UEmpathEnvQueryTest_Dot::CanRunBatched(bool bUpdateLineAPerItem, bool bUpdateLineBPerItem) const
+{
+	// Per item rotations require looking up each item's rotation through the item type, so leave those to the regular path
+	return (EQSDotBatched->GetInt() != 0)
+		&& (!bUpdateLineAPerItem || LineA.DirMode != EEnvDirection::Rotation)
+		&& (!bUpdateLineBPerItem || LineB.DirMode != EEnvDirection::Rotation);
+}
+
+namespace EmpathDotTestBatch
+{
+	/** Directions for one line of the test, either shared by all items or stored contiguously per item. */
+	struct FLineDirections
+	{
+		const FVector* Directions;
+		int32 NumPerItem;
+		int32 ItemStride;
+
+		const FVector* GetItemDirections(int32 ItemIndex) const { return Directions + (ItemIndex * ItemStride); }
+	};
+
+	/** Computes the dot products of every line pair for every item. The test mode is a template parameter so that it is resolved outside of the loop. */
+	template<bool bDot2D, bool bAbsoluteValue>
+	void ComputeDotProducts(float* OutValues, int32 NumItems, FLineDirections const& LineA, FLineDirections const& LineB)
+	{
+		for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+		{
+			const FVector* const ItemADirs = LineA.GetItemDirections(ItemIndex);
+			const FVector* const ItemBDirs = LineB.GetItemDirections(ItemIndex);
+			for (int32 LineAIndex = 0; LineAIndex < LineA.NumPerItem; LineAIndex++)
+			{
+				for (int32 LineBIndex = 0; LineBIndex < LineB.NumPerItem; LineBIndex++)
+				{
+					float DotValue = bDot2D ? ItemADirs[LineAIndex].CosineAngle2D(ItemBDirs[LineBIndex]) : FVector::DotProduct(ItemADirs[LineAIndex], ItemBDirs[LineBIndex]);
+					if (bAbsoluteValue)
+					{
+						DotValue = FMath::Abs(DotValue);
+					}
+					*OutValues++ = DotValue;
+				}
+			}
+		}
+	}
+}
+
+void UEmpathEnvQueryTest_Dot::RunTestBatched(FEnvQueryInstance& QueryInstance, const TArray<FVector>& LineADirs, const TArray<FVector>& LineBDirs,
+	bool bUpdateLineAPerItem, bool bUpdateLineBPerItem, float MinThresholdValue, float MaxThresholdValue) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_EQSTestDotBatched);
+
+	const int32 NumItems = QueryInstance.Items.Num();
+	if (NumItems == 0)
+	{
+		return;
+	}
+
+	// pull all item locations into a contiguous buffer
+	TArray<FVector> ItemLocations;
+	if (bUpdateLineAPerItem || bUpdateLineBPerItem)
+	{
+		ItemLocations.SetNumUninitialized(NumItems);
+		for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+		{
+			ItemLocations[ItemIndex] = GetItemLocation(QueryInstance, ItemIndex);
+		}
+	}
+
+	// gather directions for both lines
+	TArray<FVector> ItemLineADirs;
+	EmpathDotTestBatch::FLineDirections BatchLineA = { LineADirs.GetData(), LineADirs.Num(), 0 };
+	if (bUpdateLineAPerItem)
+	{
+		GatherLineDirectionsBatched(ItemLineADirs, BatchLineA.NumPerItem, QueryInstance, ItemLocations, LineA.LineFrom, LineA.LineTo);
+		BatchLineA.Directions = ItemLineADirs.GetData();
+		BatchLineA.ItemStride = BatchLineA.NumPerItem;
+	}
+
+	TArray<FVector> ItemLineBDirs;
+	EmpathDotTestBatch::FLineDirections BatchLineB = { LineBDirs.GetData(), LineBDirs.Num(), 0 };
+	if (bUpdateLineBPerItem)
+	{
+		GatherLineDirectionsBatched(ItemLineBDirs, BatchLineB.NumPerItem, QueryInstance, ItemLocations, LineB.LineFrom, LineB.LineTo);
+		BatchLineB.Directions = ItemLineBDirs.GetData();
+		BatchLineB.ItemStride = BatchLineB.NumPerItem;
+	}
+
+	const int32 NumPairs = BatchLineA.NumPerItem * BatchLineB.NumPerItem;
+	if (NumPairs == 0)
+	{
+		return;
+	}
+
+	// compute all dot products
+	TArray<float> DotValues;
+	DotValues.SetNumUninitialized(NumItems * NumPairs);
+	switch (TestMode)
+	{
+	case EEnvTestDot::Dot3D:
+		if (bAbsoluteValue)
+		{
+			EmpathDotTestBatch::ComputeDotProducts<false, true>(DotValues.GetData(), NumItems, BatchLineA, BatchLineB);
+		}
+		else
+		{
+			EmpathDotTestBatch::ComputeDotProducts<false, false>(DotValues.GetData(), NumItems, BatchLineA, BatchLineB);
+		}
+		break;
+
+	case EEnvTestDot::Dot2D:
+		if (bAbsoluteValue)
+		{
+			EmpathDotTestBatch::ComputeDotProducts<true, true>(DotValues.GetData(), NumItems, BatchLineA, BatchLineB);
+		}
+		else
+		{
+			EmpathDotTestBatch::ComputeDotProducts<true, false>(DotValues.GetData(), NumItems, BatchLineA, BatchLineB);
+		}
+		break;
+
+	default:
+		UE_LOG(LogEQS, Error, TEXT("Invalid TestMode in EmpathEnvQueryTest_Dot in query %s!"), *QueryInstance.QueryName);
+		FMemory::Memzero(DotValues.GetData(), DotValues.Num() * sizeof(float));
+		break;
+	}
+	INC_DWORD_STAT_BY(STAT_EMPATH_EQSTestDotScratchBytes, ItemLocations.GetAllocatedSize() + ItemLineADirs.GetAllocatedSize() + ItemLineBDirs.GetAllocatedSize() + DotValues.GetAllocatedSize());
+
+	// write the scores back in the same order as the per item path
+	for (FEnvQueryInstance::ItemIterator It(this, QueryInstance); It; ++It)
+	{
+		const float* ItemDotValues = DotValues.GetData() + (It.GetIndex() * NumPairs);
+		for (int32 PairIndex = 0; PairIndex < NumPairs; PairIndex++)
+		{
+			It.SetScore(TestPurpose, FilterType, ItemDotValues[PairIndex], MinThresholdValue, MaxThresholdValue);
+		}
+	}
+}
+
+void UEmpathEnvQueryTest_Dot::GatherLineDirectionsBatched(TArray<FVector>& Directions, int32& NumDirectionsPerItem, FEnvQueryInstance& QueryInstance, const TArray<FVector>& ItemLocations,
+	TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo) const
+{
+	// contexts that are not the item are the same for every item, so only prepare them once
+	const bool bFromItem = IsContextPerItem(LineFrom);
+	const bool bToItem = IsContextPerItem(LineTo);
+
+	TArray<FVector> ContextLocationFrom;
+	if (!bFromItem)
+	{
+		QueryInstance.PrepareContext(LineFrom, ContextLocationFrom);
+	}
+
+	TArray<FVector> ContextLocationTo;
+	if (!bToItem)
+	{
+		QueryInstance.PrepareContext(LineTo, ContextLocationTo);
+	}
+
+	const int32 NumItems = ItemLocations.Num();
+	const int32 NumFrom = bFromItem ? 1 : ContextLocationFrom.Num();
+	const int32 NumTo = bToItem ? 1 : ContextLocationTo.Num();
+	NumDirectionsPerItem = NumFrom * NumTo;
+	Directions.SetNumUninitialized(NumItems * NumDirectionsPerItem);
+
+	// fill in directions in the same from/to order as the per item path
+	for (int32 FromIndex = 0; FromIndex < NumFrom; FromIndex++)
+	{
+		for (int32 ToIndex = 0; ToIndex < NumTo; ToIndex++)
+		{
+			const int32 DirOffset = (FromIndex * NumTo) + ToIndex;
+			if (bFromItem && bToItem)
+			{
+				for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+				{
+					Directions[(ItemIndex * NumDirectionsPerItem) + DirOffset] = FVector::ZeroVector;
+				}
+			}
+			else if (bFromItem)
+			{
+				const FVector LocationTo = ContextLocationTo[ToIndex];
+				for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+				{
+					Directions[(ItemIndex * NumDirectionsPerItem) + DirOffset] = (LocationTo - ItemLocations[ItemIndex]).GetSafeNormal();
+				}
+			}
+			else if (bToItem)
+			{
+				const FVector LocationFrom = ContextLocationFrom[FromIndex];
+				for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+				{
+					Directions[(ItemIndex * NumDirectionsPerItem) + DirOffset] = (ItemLocations[ItemIndex] - LocationFrom).GetSafeNormal();
+				}
+			}
+			else
+			{
+				const FVector Dir = (ContextLocationTo[ToIndex] - ContextLocationFrom[FromIndex]).GetSafeNormal();
+				for (int32 ItemIndex = 0; ItemIndex < NumItems; ItemIndex++)
+				{
+					Directions[(ItemIndex * NumDirectionsPerItem) + DirOffset] = Dir;
+				}
+			}
+		}
+	}
+}
+
 void UEmpathEnvQueryTest_Dot::GatherLineDirections(TArray<FVector>& Directions, FEnvQueryInstance& QueryInstance, const FVector& ItemLocation,
 	TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo) const
 {
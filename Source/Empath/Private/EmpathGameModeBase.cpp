@@ -13,4 +13,13 @@ AEmpathGameModeBase::AEmpathGameModeBase(const FObjectInitializer& ObjectInitial
 void AEmpathGameModeBase::BeginPlay()
 {
 	AIManager = (AEmpathAIManager*)GetWorld()->SpawnActor<AEmpathAIManager>();
+
+	// Fill the character pool up front so that spawning enemies later does not hitch
+	if (AIManager)
+	{
+		for (FEmpathCharacterPoolPrewarm const& Prewarm : CharacterPoolPrewarm)
+		{
+			AIManager->PrewarmCharacterPool(Prewarm.CharacterClass, Prewarm.Count);
+		}
+	}
 }
\ No newline at end of file
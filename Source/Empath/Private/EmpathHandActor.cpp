@@ -1,6 +1,7 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathHandActor.h"
+#include "Empath.h"
 #include "Components/SphereComponent.h"
 #include "EmpathTypes.h"
 #include "EmpathKinematicVelocityComponent.h"
@@ -8,6 +9,11 @@
 #include "EmpathGripObjectInterface.h"
 #include "EmpathPlayerCharacter.h"
 
+// Stats for UE Profiler
+DECLARE_CYCLE_STAT(TEXT("Empath Hand Get Best Grip Candidate"), STAT_EMPATH_GetBestGripCandidate, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Hand Get Best Grip Candidate Calls"), STAT_EMPATH_GetBestGripCandidateCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath Hand Grip Candidates Checked"), STAT_EMPATH_GripCandidatesChecked, STATGROUP_EMPATH);
+
 FName AEmpathHandActor::BlockingCollisionName(TEXT("BlockingCollision"));
 FName AEmpathHandActor::KinematicVelocityComponentName(TEXT("KinematicVelocityComponent"));
 FName AEmpathHandActor::MeshComponentName(TEXT("MeshComponent"));
@@ -60,6 +66,16 @@ AEmpathHandActor::AEmpathHandActor(const FObjectInitializer& ObjectInitializer)
 void AEmpathHandActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Track grip candidates as they overlap, starting with anything we are already overlapping
+	GripCollision->OnComponentBeginOverlap.AddDynamic(this, &AEmpathHandActor::OnGripCollisionBeginOverlap);
+	GripCollision->OnComponentEndOverlap.AddDynamic(this, &AEmpathHandActor::OnGripCollisionEndOverlap);
+	TArray<UPrimitiveComponent*> OverlappingComponents;
+	GripCollision->GetOverlappingComponents(OverlappingComponents);
+	for (UPrimitiveComponent* CurrComponent : OverlappingComponents)
+	{
+		AddGripCandidate(CurrComponent);
+	}
 }
 
 // Called every frame
@@ -172,54 +188,81 @@ FVector AEmpathHandActor::GetTeleportDirection_Implementation(FVector LocalDirec
 	return GetTransform().TransformVectorNoScale(LocalDirection.GetSafeNormal());
 }
 
+void AEmpathHandActor::OnGripCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	AddGripCandidate(OtherComp);
+}
+
+void AEmpathHandActor::OnGripCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// Multi-body components send an event per body, so only remove the candidate once the component has stopped overlapping entirely
+	if (OtherComp && !GripCollision->IsOverlappingComponent(OtherComp))
+	{
+		GripCandidates.RemoveAllSwap([OtherComp](const FGripCandidate& Candidate) { return Candidate.Component.Get() == OtherComp; });
+	}
+}
+
+void AEmpathHandActor::AddGripCandidate(UPrimitiveComponent* Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	// Ignore components we are already tracking
+	for (const FGripCandidate& Candidate : GripCandidates)
+	{
+		if (Candidate.Component.Get() == Component)
+		{
+			return;
+		}
+	}
+
+	// Only track components whose owner can respond to grips
+	AActor* const ComponentOwner = Component->GetOwner();
+	if (ComponentOwner && ComponentOwner->GetClass()->ImplementsInterface(UEmpathGripObjectInterface::StaticClass()))
+	{
+		GripCandidates.Emplace(Component, ComponentOwner);
+	}
+}
+
 void AEmpathHandActor::GetBestGripCandidate(AActor*& GripActor, UPrimitiveComponent*& GripComponent, EEmpathGripType& GripResponse)
 {
-	// Get all overlapping components
-	TArray<UPrimitiveComponent*> OverlappingComponents;
-	GripCollision->GetOverlappingComponents(OverlappingComponents);
+	// Track how long it takes to complete this function for the profiler
+	SCOPE_CYCLE_COUNTER(STAT_EMPATH_GetBestGripCandidate);
+	INC_DWORD_STAT(STAT_EMPATH_GetBestGripCandidateCalls);
+	INC_DWORD_STAT_BY(STAT_EMPATH_GripCandidatesChecked, GripCandidates.Num());
+
+	GripActor = nullptr;
+	GripComponent = nullptr;
+	GripResponse = EEmpathGripType::NoGrip;
 
 	float BestDistance = 99999.0f;
-	bool bFoundActor = false;
+	FVector const GripLocation = GripCollision->GetComponentLocation();
 
-	// Check each overlapping component
-	for (UPrimitiveComponent* CurrComponent : OverlappingComponents)
+	// Check each cached candidate, dropping any that were destroyed without an end overlap
+	for (int32 Idx = GripCandidates.Num() - 1; Idx >= 0; --Idx)
 	{
-		AActor* CurrActor = CurrComponent->GetOwner();
-
-		// If this is a new actor, we need to check if it implements the interface, and if so, what the response is
-		if (CurrActor != GripActor)
+		UPrimitiveComponent* const CurrComponent = GripCandidates[Idx].Component.Get();
+		AActor* const CurrActor = GripCandidates[Idx].Actor.Get();
+		if (!CurrComponent || !CurrActor)
 		{
-			if (CurrActor->GetClass()->ImplementsInterface(UEmpathGripObjectInterface::StaticClass()))
-			{
-				EEmpathGripType CurrGripResponse = IEmpathGripObjectInterface::Execute_GetGripResponse(CurrActor, this, CurrComponent);
-				if (CurrGripResponse != EEmpathGripType::NoGrip)
-				{
-					// Check the distance to this component is smaller than the current best. If so, update the current best
-					float CurrDist = (CurrComponent->GetComponentLocation() - GripCollision->GetComponentLocation()).Size();
-					if (CurrDist < BestDistance)
-					{
-						GripActor = CurrActor;
-						GripComponent = CurrComponent;
-						BestDistance = CurrDist;
-						GripResponse = CurrGripResponse;
-					}
-				}
-			}
+			GripCandidates.RemoveAtSwap(Idx);
+			continue;
 		}
 
-		// If this is our current best actor, then we can skip checking if it implements the interface
-		else
+		// The response may change at runtime, so we still need to ask for it
+		EEmpathGripType CurrGripResponse = IEmpathGripObjectInterface::Execute_GetGripResponse(CurrActor, this, CurrComponent);
+		if (CurrGripResponse != EEmpathGripType::NoGrip)
 		{
-			EEmpathGripType CurrGripResponse = IEmpathGripObjectInterface::Execute_GetGripResponse(CurrActor, this, CurrComponent);
-			if (CurrGripResponse != EEmpathGripType::NoGrip)
+			// Check the distance to this component is smaller than the current best. If so, update the current best
+			float CurrDist = (CurrComponent->GetComponentLocation() - GripLocation).Size();
+			if (CurrDist < BestDistance)
 			{
-				float CurrDist = (CurrComponent->GetComponentLocation() - GripCollision->GetComponentLocation()).Size();
-				if (CurrDist < BestDistance)
-				{
-					GripComponent = CurrComponent;
-					BestDistance = CurrDist;
-					GripResponse = CurrGripResponse;
-				}
+				GripActor = CurrActor;
+				GripComponent = CurrComponent;
+				BestDistance = CurrDist;
+				GripResponse = CurrGripResponse;
 			}
 		}
 	}
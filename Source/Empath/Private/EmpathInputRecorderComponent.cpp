@@ -0,0 +1,454 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#include "EmpathInputRecorderComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerInput.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Engine/Engine.h"
+#include "VRBaseCharacter.h"
+#include "ReplicatedVRCameraComponent.h"
+#include "GripMotionControllerComponent.h"
+
+// Log categories
+DEFINE_LOG_CATEGORY_STATIC(LogEmpathInputRecorder, Log, All);
+
+// File header for input recordings. Bump the version whenever FEmpathRecordedInputFrame changes.
+static const uint32 EmpathInputRecordingMagic = 0x52494D45; // 'EMIR'
+static const int32 EmpathInputRecordingVersion = 1;
+
+// Sets default values for this component's properties
+UEmpathInputRecorderComponent::UEmpathInputRecorderComponent()
+{
+	// We only need to tick while recording or playing back
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	bUseRecordedDeltaTime = true;
+	PlaybackFixedDeltaTime = 1.0f / 90.0f;
+	bExitWhenPlaybackFinished = false;
+	CsvStatGroups.Add(FName(TEXT("EMPATH")));
+	CsvStatGroups.Add(FName(TEXT("EMPATH_Character")));
+	CsvStatGroups.Add(FName(TEXT("EMPATH_VRCharacter")));
+	CsvStatGroups.Add(FName(TEXT("EMPATH_AICon")));
+	CsvStatGroups.Add(FName(TEXT("EMPATH_AIManager")));
+	CsvStatGroups.Add(FName(TEXT("TICKGrip")));
+	CsvStatGroups.Add(FName(TEXT("VRRootComponent")));
+	CsvStatGroups.Add(FName(TEXT("VRPoseFilter")));
+	CsvStatGroups.Add(FName(TEXT("ReplicatedVRCamera")));
+	CsvStatGroups.Add(FName(TEXT("VRCharacterRepulsion")));
+	CsvStatGroups.Add(FName(TEXT("VRSimpleCharacterMovement")));
+
+	bRecording = false;
+	bPlayingBack = false;
+	PlaybackFrameIndex = 0;
+	bPrePlaybackUseFixedTimeStep = false;
+	PrePlaybackFixedDeltaTime = 0.0;
+	bPrePlaybackLeftUseWithoutTracking = false;
+	bPrePlaybackRightUseWithoutTracking = false;
+}
+
+// Called every frame
+void UEmpathInputRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bRecording)
+	{
+		RecordFrame(FApp::GetDeltaTime());
+	}
+	else if (bPlayingBack)
+	{
+		// Stats are for the frame that just finished
+		StatsCsvWriter.WriteFrame(FApp::GetDeltaTime());
+		PlayFrame();
+	}
+}
+
+void UEmpathInputRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bRecording)
+	{
+		StopRecording();
+	}
+	if (bPlayingBack)
+	{
+		StopPlayback();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UEmpathInputRecorderComponent::StartRecording(const FString& FileName)
+{
+	if (bRecording || bPlayingBack || !GetOwningPlayerController())
+	{
+		return false;
+	}
+
+	RecordingFilePath = GetRecordingPath(FileName);
+	KeyNames.Empty();
+	KeyNameIndices.Empty();
+	Frames.Empty();
+	PendingEvents.Empty();
+	bRecording = true;
+
+	// Make sure we capture before our owner processes input
+	GetOwner()->AddTickPrerequisiteComponent(this);
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogEmpathInputRecorder, Log, TEXT("Recording input to %s"), *RecordingFilePath);
+	return true;
+}
+
+void UEmpathInputRecorderComponent::StopRecording()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+	SetComponentTickEnabled(false);
+	GetOwner()->RemoveTickPrerequisiteComponent(this);
+
+	// Serialize the key table and frames
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	uint32 Magic = EmpathInputRecordingMagic;
+	int32 Version = EmpathInputRecordingVersion;
+	TArray<FString> KeyNameStrings;
+	KeyNameStrings.Reserve(KeyNames.Num());
+	for (const FName& KeyName : KeyNames)
+	{
+		KeyNameStrings.Add(KeyName.ToString());
+	}
+	Writer << Magic << Version << KeyNameStrings << Frames;
+
+	if (FFileHelper::SaveArrayToFile(FileData, *RecordingFilePath))
+	{
+		UE_LOG(LogEmpathInputRecorder, Log, TEXT("Saved %d frames (%d bytes) of input to %s"), Frames.Num(), FileData.Num(), *RecordingFilePath);
+	}
+	else
+	{
+		UE_LOG(LogEmpathInputRecorder, Warning, TEXT("Could not save input recording to %s"), *RecordingFilePath);
+	}
+
+	Frames.Empty();
+	PendingEvents.Empty();
+}
+
+bool UEmpathInputRecorderComponent::StartPlayback(const FString& FileName, const FString& CsvFileName)
+{
+	if (bRecording || bPlayingBack || !GetOwningPlayerController())
+	{
+		return false;
+	}
+
+	// Load and validate the recording
+	const FString FilePath = GetRecordingPath(FileName);
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		UE_LOG(LogEmpathInputRecorder, Warning, TEXT("Could not load input recording %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != EmpathInputRecordingMagic || Version != EmpathInputRecordingVersion)
+	{
+		UE_LOG(LogEmpathInputRecorder, Warning, TEXT("%s is not a valid input recording or is from a different version"), *FilePath);
+		return false;
+	}
+
+	TArray<FString> KeyNameStrings;
+	Reader << KeyNameStrings << Frames;
+	if (Reader.IsError() || Frames.Num() == 0)
+	{
+		UE_LOG(LogEmpathInputRecorder, Warning, TEXT("Input recording %s is empty or corrupt"), *FilePath);
+		Frames.Empty();
+		return false;
+	}
+
+	KeyNames.Empty(KeyNameStrings.Num());
+	for (const FString& KeyNameString : KeyNameStrings)
+	{
+		KeyNames.Add(FName(*KeyNameString));
+	}
+
+	// Drive the tracked components ourselves. With no tracking system the controllers would otherwise stop updating.
+	AVRBaseCharacter* VRChar = GetControlledVRCharacter();
+	PlaybackCharacter = VRChar;
+	if (VRChar)
+	{
+		VRChar->AddTickPrerequisiteComponent(this);
+		if (VRChar->VRReplicatedCamera)
+		{
+			VRChar->VRReplicatedCamera->AddTickPrerequisiteComponent(this);
+		}
+		if (VRChar->LeftMotionController)
+		{
+			bPrePlaybackLeftUseWithoutTracking = VRChar->LeftMotionController->bUseWithoutTracking;
+			VRChar->LeftMotionController->bUseWithoutTracking = true;
+			VRChar->LeftMotionController->AddTickPrerequisiteComponent(this);
+		}
+		if (VRChar->RightMotionController)
+		{
+			bPrePlaybackRightUseWithoutTracking = VRChar->RightMotionController->bUseWithoutTracking;
+			VRChar->RightMotionController->bUseWithoutTracking = true;
+			VRChar->RightMotionController->AddTickPrerequisiteComponent(this);
+		}
+	}
+	GetOwner()->AddTickPrerequisiteComponent(this);
+
+	// Run with a fixed timestep so playback is deterministic and not limited by the frame rate
+	bPrePlaybackUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PrePlaybackFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(bUseRecordedDeltaTime ? Frames[0].DeltaTime : PlaybackFixedDeltaTime);
+
+	if (!CsvFileName.IsEmpty() && StatsCsvWriter.Open(CsvFileName))
+	{
+		EnableCsvStatGroups();
+	}
+
+	PlaybackFrameIndex = 0;
+	bPlayingBack = true;
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogEmpathInputRecorder, Log, TEXT("Playing back %d frames of input from %s"), Frames.Num(), *FilePath);
+	return true;
+}
+
+void UEmpathInputRecorderComponent::StopPlayback()
+{
+	if (!bPlayingBack)
+	{
+		return;
+	}
+
+	bPlayingBack = false;
+	SetComponentTickEnabled(false);
+
+	if (StatsCsvWriter.IsOpen())
+	{
+		RestoreCsvStatGroups();
+		StatsCsvWriter.Close();
+	}
+
+	FApp::SetUseFixedTimeStep(bPrePlaybackUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PrePlaybackFixedDeltaTime);
+
+	if (AVRBaseCharacter* VRChar = PlaybackCharacter.Get())
+	{
+		VRChar->RemoveTickPrerequisiteComponent(this);
+		if (VRChar->VRReplicatedCamera)
+		{
+			VRChar->VRReplicatedCamera->RemoveTickPrerequisiteComponent(this);
+		}
+		if (VRChar->LeftMotionController)
+		{
+			VRChar->LeftMotionController->bUseWithoutTracking = bPrePlaybackLeftUseWithoutTracking;
+			VRChar->LeftMotionController->RemoveTickPrerequisiteComponent(this);
+		}
+		if (VRChar->RightMotionController)
+		{
+			VRChar->RightMotionController->bUseWithoutTracking = bPrePlaybackRightUseWithoutTracking;
+			VRChar->RightMotionController->RemoveTickPrerequisiteComponent(this);
+		}
+	}
+	PlaybackCharacter.Reset();
+	GetOwner()->RemoveTickPrerequisiteComponent(this);
+
+	UE_LOG(LogEmpathInputRecorder, Log, TEXT("Finished input playback after %d of %d frames"), PlaybackFrameIndex, Frames.Num());
+	Frames.Empty();
+}
+
+void UEmpathInputRecorderComponent::RecordKey(FKey Key, EInputEvent EventType, float AmountDepressed, bool bGamepad)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FEmpathRecordedInputEvent& NewEvent = PendingEvents[PendingEvents.AddDefaulted()];
+	NewEvent.KeyIndex = GetKeyIndex(Key);
+	NewEvent.EventType = (uint8)EventType;
+	NewEvent.Value = AmountDepressed;
+	NewEvent.bGamepad = bGamepad;
+}
+
+void UEmpathInputRecorderComponent::RecordAxis(FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FEmpathRecordedInputEvent& NewEvent = PendingEvents[PendingEvents.AddDefaulted()];
+	NewEvent.KeyIndex = GetKeyIndex(Key);
+	NewEvent.EventType = FEmpathRecordedInputEvent::AxisEventType;
+	NewEvent.Value = Delta;
+	NewEvent.AxisDeltaTime = DeltaTime;
+	NewEvent.NumSamples = NumSamples;
+	NewEvent.bGamepad = bGamepad;
+}
+
+APlayerController* UEmpathInputRecorderComponent::GetOwningPlayerController() const
+{
+	return Cast<APlayerController>(GetOwner());
+}
+
+AVRBaseCharacter* UEmpathInputRecorderComponent::GetControlledVRCharacter() const
+{
+	APlayerController* OwningPC = GetOwningPlayerController();
+	return OwningPC ? Cast<AVRBaseCharacter>(OwningPC->GetPawn()) : nullptr;
+}
+
+uint16 UEmpathInputRecorderComponent::GetKeyIndex(const FKey& Key)
+{
+	const FName KeyName = Key.GetFName();
+	if (const uint16* ExistingIndex = KeyNameIndices.Find(KeyName))
+	{
+		return *ExistingIndex;
+	}
+
+	const uint16 NewIndex = (uint16)KeyNames.Add(KeyName);
+	KeyNameIndices.Add(KeyName, NewIndex);
+	return NewIndex;
+}
+
+void UEmpathInputRecorderComponent::RecordFrame(float DeltaTime)
+{
+	FEmpathRecordedInputFrame& NewFrame = Frames[Frames.AddDefaulted()];
+	NewFrame.DeltaTime = DeltaTime;
+	NewFrame.Events = MoveTemp(PendingEvents);
+	PendingEvents.Reset();
+
+	// Tracked transforms are stored relative to the pawn, the same space the tracking system updates them in
+	AVRBaseCharacter* VRChar = GetControlledVRCharacter();
+	if (VRChar)
+	{
+		if (VRChar->VRReplicatedCamera)
+		{
+			NewFrame.HMDLocation = VRChar->VRReplicatedCamera->RelativeLocation;
+			NewFrame.HMDRotation = VRChar->VRReplicatedCamera->RelativeRotation.Quaternion();
+		}
+		if (VRChar->LeftMotionController)
+		{
+			NewFrame.LeftHandLocation = VRChar->LeftMotionController->RelativeLocation;
+			NewFrame.LeftHandRotation = VRChar->LeftMotionController->RelativeRotation.Quaternion();
+		}
+		if (VRChar->RightMotionController)
+		{
+			NewFrame.RightHandLocation = VRChar->RightMotionController->RelativeLocation;
+			NewFrame.RightHandRotation = VRChar->RightMotionController->RelativeRotation.Quaternion();
+		}
+	}
+}
+
+void UEmpathInputRecorderComponent::PlayFrame()
+{
+	if (PlaybackFrameIndex >= Frames.Num())
+	{
+		StopPlayback();
+		if (bExitWhenPlaybackFinished)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return;
+	}
+
+	const FEmpathRecordedInputFrame& CurrentFrame = Frames[PlaybackFrameIndex++];
+
+	// Apply the tracked transforms
+	if (AVRBaseCharacter* VRChar = PlaybackCharacter.Get())
+	{
+		if (VRChar->VRReplicatedCamera)
+		{
+			VRChar->VRReplicatedCamera->SetRelativeLocationAndRotation(CurrentFrame.HMDLocation, CurrentFrame.HMDRotation);
+		}
+		if (VRChar->LeftMotionController)
+		{
+			VRChar->LeftMotionController->SetRelativeLocationAndRotation(CurrentFrame.LeftHandLocation, CurrentFrame.LeftHandRotation);
+		}
+		if (VRChar->RightMotionController)
+		{
+			VRChar->RightMotionController->SetRelativeLocationAndRotation(CurrentFrame.RightHandLocation, CurrentFrame.RightHandRotation);
+		}
+	}
+
+	// Feed the input events straight to the player input, the same way the controller would have received them
+	APlayerController* OwningPC = GetOwningPlayerController();
+	if (OwningPC && OwningPC->PlayerInput)
+	{
+		for (const FEmpathRecordedInputEvent& CurrentEvent : CurrentFrame.Events)
+		{
+			if (!KeyNames.IsValidIndex(CurrentEvent.KeyIndex))
+			{
+				continue;
+			}
+
+			const FKey Key(KeyNames[CurrentEvent.KeyIndex]);
+			if (CurrentEvent.EventType == FEmpathRecordedInputEvent::AxisEventType)
+			{
+				OwningPC->PlayerInput->InputAxis(Key, CurrentEvent.Value, CurrentEvent.AxisDeltaTime, CurrentEvent.NumSamples, CurrentEvent.bGamepad);
+			}
+			else
+			{
+				OwningPC->PlayerInput->InputKey(Key, (EInputEvent)CurrentEvent.EventType, CurrentEvent.Value, CurrentEvent.bGamepad);
+			}
+		}
+	}
+
+	// Set up the timestep for the next frame
+	if (PlaybackFrameIndex < Frames.Num())
+	{
+		FApp::SetFixedDeltaTime(bUseRecordedDeltaTime ? Frames[PlaybackFrameIndex].DeltaTime : PlaybackFixedDeltaTime);
+	}
+}
+
+void UEmpathInputRecorderComponent::EnableCsvStatGroups()
+{
+	EnabledCsvStatGroups.Reset();
+#if STATS
+	if (GEngine)
+	{
+		for (const FName& StatGroup : CsvStatGroups)
+		{
+			// The stat command toggles, so running it on a group that is already on would turn it off
+			if (!EnabledCsvStatGroups.Contains(StatGroup) && !FEmpathStatsCsvWriter::IsStatGroupActive(StatGroup))
+			{
+				GEngine->Exec(GetWorld(), *FString::Printf(TEXT("stat %s"), *StatGroup.ToString()));
+				EnabledCsvStatGroups.Add(StatGroup);
+			}
+		}
+	}
+#endif
+}
+
+void UEmpathInputRecorderComponent::RestoreCsvStatGroups()
+{
+#if STATS
+	if (GEngine)
+	{
+		for (const FName& StatGroup : EnabledCsvStatGroups)
+		{
+			GEngine->Exec(GetWorld(), *FString::Printf(TEXT("stat %s"), *StatGroup.ToString()));
+		}
+	}
+#endif
+	EnabledCsvStatGroups.Reset();
+}
+
+FString UEmpathInputRecorderComponent::GetRecordingPath(const FString& FileName)
+{
+	return FPaths::IsRelative(FileName) ? FPaths::ProjectSavedDir() / TEXT("InputRecordings") / FileName : FileName;
+}
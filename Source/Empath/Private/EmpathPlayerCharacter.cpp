@@ -1,6 +1,7 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathPlayerCharacter.h"
+#include "Empath.h"
 #include "EmpathPlayerController.h"
 #include "EmpathDamageType.h"
 #include "EmpathFunctionLibrary.h"
@@ -14,8 +15,11 @@
 #include "Runtime/HeadMountedDisplay/Public/HeadMountedDisplayFunctionLibrary.h"
 
 // Stats for UE Profiler
-DECLARE_CYCLE_STAT(TEXT("Empath VR Char Take Damage"), STAT_EMPATH_PlayerTakeDamage, STATGROUP_EMPATH_VRCharacter);
-DECLARE_CYCLE_STAT(TEXT("Empath VR Char Teleport Trace"), STAT_EMPATH_TraceTeleport, STATGROUP_EMPATH_VRCharacter);
+DECLARE_CYCLE_STAT(TEXT("Empath VR Char Take Damage"), STAT_EMPATH_PlayerTakeDamage, STATGROUP_EMPATH);
+DECLARE_CYCLE_STAT(TEXT("Empath VR Char Teleport Trace"), STAT_EMPATH_TraceTeleport, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath VR Char Take Damage Calls"), STAT_EMPATH_PlayerTakeDamageCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath VR Char Teleport Trace Calls"), STAT_EMPATH_TraceTeleportCalls, STATGROUP_EMPATH);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Empath VR Char Teleport Trace Scratch Bytes"), STAT_EMPATH_TraceTeleportScratchBytes, STATGROUP_EMPATH);
 
 // Log categories
 DEFINE_LOG_CATEGORY_STATIC(LogTeleportTrace, Log, All);
@@ -337,6 +341,7 @@ float AEmpathPlayerCharacter::TakeDamage(float DamageAmount, FDamageEvent const&
 {
 	// Scope these functions for the UE4 profiler
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_PlayerTakeDamage);
+	INC_DWORD_STAT(STAT_EMPATH_PlayerTakeDamageCalls);
 
 	// If we're invincible, dead, or this is no damage, do nothing
 	if (bInvincible || bDead || DamageAmount <= 0.0f)
@@ -584,6 +589,7 @@ bool AEmpathPlayerCharacter::TraceTeleportLocation(FVector Origin, FVector Direc
 {
 	// Declare scope cycle for profiler
 	SCOPE_CYCLE_COUNTER(STAT_EMPATH_TraceTeleport);
+	INC_DWORD_STAT(STAT_EMPATH_TraceTeleportCalls);
 
 	// Update the velocity
 	if (bInterpolateMagnitude)
@@ -630,6 +636,7 @@ bool AEmpathPlayerCharacter::TraceTeleportLocation(FVector Origin, FVector Direc
 	// Do the trace and update variables
 	FPredictProjectilePathResult TraceResult;
 	bool TraceHit = UGameplayStatics::PredictProjectilePath(this, TeleportTraceParams, TraceResult);
+	INC_DWORD_STAT_BY(STAT_EMPATH_TraceTeleportScratchBytes, BeaconTraceHits.GetAllocatedSize() + OverlappingTeleportTargets.GetAllocatedSize() + TraceResult.PathData.GetAllocatedSize());
 	TeleportTraceSplinePositions.Empty(TraceResult.PathData.Num());
 	for (const FPredictProjectilePathPointData& PathPoint : TraceResult.PathData)
 	{
@@ -1,7 +1,87 @@
 // Copyright 2018 Team Empath All Rights Reserved
 
 #include "EmpathPlayerController.h"
+#include "EmpathInputRecorderComponent.h"
 
+AEmpathPlayerController::AEmpathPlayerController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	InputRecorder = CreateDefaultSubobject<UEmpathInputRecorderComponent>(TEXT("InputRecorder"));
+}
 
+void AEmpathPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
 
+	// Start playback from the command line for automated runs, ie:
+	// -EmpathReplayInput=Session.vrinput -EmpathReplayCsv=Session.csv -nullrhi
+	FString ReplayFileName;
+	if (IsLocalController() && InputRecorder && FParse::Value(FCommandLine::Get(), TEXT("EmpathReplayInput="), ReplayFileName))
+	{
+		FString CsvFileName;
+		FParse::Value(FCommandLine::Get(), TEXT("EmpathReplayCsv="), CsvFileName);
+		InputRecorder->bExitWhenPlaybackFinished = true;
+		InputRecorder->StartPlayback(ReplayFileName, CsvFileName);
+	}
+}
 
+bool AEmpathPlayerController::InputKey(FKey Key, EInputEvent EventType, float AmountDepressed, bool bGamepad)
+{
+	if (InputRecorder)
+	{
+		// Live input would make playback diverge from the recording
+		if (InputRecorder->IsPlayingBack())
+		{
+			return false;
+		}
+		InputRecorder->RecordKey(Key, EventType, AmountDepressed, bGamepad);
+	}
+
+	return Super::InputKey(Key, EventType, AmountDepressed, bGamepad);
+}
+
+bool AEmpathPlayerController::InputAxis(FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad)
+{
+	if (InputRecorder)
+	{
+		if (InputRecorder->IsPlayingBack())
+		{
+			return false;
+		}
+		InputRecorder->RecordAxis(Key, Delta, DeltaTime, NumSamples, bGamepad);
+	}
+
+	return Super::InputAxis(Key, Delta, DeltaTime, NumSamples, bGamepad);
+}
+
+void AEmpathPlayerController::EmpathRecordInput(const FString& FileName)
+{
+	if (InputRecorder)
+	{
+		InputRecorder->StartRecording(FileName);
+	}
+}
+
+void AEmpathPlayerController::EmpathStopRecordingInput()
+{
+	if (InputRecorder)
+	{
+		InputRecorder->StopRecording();
+	}
+}
+
+void AEmpathPlayerController::EmpathReplayInput(const FString& FileName, const FString& CsvFileName)
+{
+	if (InputRecorder)
+	{
+		InputRecorder->StartPlayback(FileName, CsvFileName);
+	}
+}
+
+void AEmpathPlayerController::EmpathStopReplayingInput()
+{
+	if (InputRecorder)
+	{
+		InputRecorder->StopPlayback();
+	}
+}
@@ -0,0 +1,191 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#include "EmpathStatsCsvWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "Containers/Ticker.h"
+#include "Misc/CoreDelegates.h"
+#if STATS
+#include "Stats/StatsData.h"
+#endif
+
+// Log categories
+DEFINE_LOG_CATEGORY_STATIC(LogEmpathStatsCsv, Log, All);
+
+namespace EmpathStatsCsv
+{
+	/** Writer used when capturing through the console variable. */
+	static FEmpathStatsCsvWriter ConsoleWriter;
+
+	/** Handle of the ticker that writes each frame of the console capture. */
+	static FDelegateHandle ConsoleTickerHandle;
+
+	/** Handle of the pre exit callback that closes the console capture. */
+	static FDelegateHandle PreExitHandle;
+
+	static bool TickConsoleCapture(float DeltaTime)
+	{
+		ConsoleWriter.WriteFrame(DeltaTime);
+		return true;
+	}
+
+	static void StopConsoleCapture()
+	{
+		if (ConsoleWriter.IsOpen())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(ConsoleTickerHandle);
+			ConsoleTickerHandle.Reset();
+			ConsoleWriter.Close();
+		}
+	}
+
+	static void OnConsoleCaptureChanged(IConsoleVariable* Var)
+	{
+		const bool bEnable = Var->GetInt() != 0;
+		if (bEnable && !ConsoleWriter.IsOpen())
+		{
+			const FString FileName = FString::Printf(TEXT("EmpathStats-%s.csv"), *FDateTime::Now().ToString());
+			if (ConsoleWriter.Open(FileName))
+			{
+				ConsoleTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickConsoleCapture));
+
+				// Flush and close the file while the engine is still up, rather than from the static destructor
+				if (!PreExitHandle.IsValid())
+				{
+					PreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&StopConsoleCapture);
+				}
+			}
+		}
+		else if (!bEnable)
+		{
+			StopConsoleCapture();
+		}
+	}
+}
+
+// Console variable setup so we can capture stats to a CSV from the console in any build
+static FAutoConsoleVariable CVarEmpathStatsCsv(
+	TEXT("Empath.StatsCsv"),
+	0,
+	TEXT("Whether to write per-frame timings and active stat groups to a CSV in Saved/Profiling.\n")
+	TEXT("Enable the groups to capture first, ie: \"stat EMPATH\".\n")
+	TEXT("0: Disabled, 1: Enabled"),
+	FConsoleVariableDelegate::CreateStatic(&EmpathStatsCsv::OnConsoleCaptureChanged));
+
+FEmpathStatsCsvWriter::FEmpathStatsCsvWriter()
+	: CsvArchive(nullptr),
+	FramesWritten(0)
+{
+}
+
+FEmpathStatsCsvWriter::~FEmpathStatsCsvWriter()
+{
+	// Owners close the writer before shutdown, so don't log here in case this is static destruction and the log is gone
+	if (CsvArchive)
+	{
+		CsvArchive->Close();
+		delete CsvArchive;
+		CsvArchive = nullptr;
+	}
+}
+
+bool FEmpathStatsCsvWriter::Open(const FString& FileName)
+{
+	Close();
+
+	FilePath = FPaths::IsRelative(FileName) ? FPaths::ProfilingDir() / FileName : FileName;
+	CsvArchive = IFileManager::Get().CreateFileWriter(*FilePath);
+	if (!CsvArchive)
+	{
+		UE_LOG(LogEmpathStatsCsv, Warning, TEXT("Could not open stats CSV %s"), *FilePath);
+		return false;
+	}
+
+	FramesWritten = 0;
+	FTCHARToUTF8 Header(TEXT("Frame,Group,Stat,Value\n"));
+	CsvArchive->Serialize((UTF8CHAR*)Header.Get(), Header.Length());
+	UE_LOG(LogEmpathStatsCsv, Log, TEXT("Writing stats CSV to %s"), *FilePath);
+	return true;
+}
+
+void FEmpathStatsCsvWriter::Close()
+{
+	if (CsvArchive)
+	{
+		CsvArchive->Close();
+		delete CsvArchive;
+		CsvArchive = nullptr;
+		UE_LOG(LogEmpathStatsCsv, Log, TEXT("Closed stats CSV %s after %u frames"), *FilePath, FramesWritten);
+	}
+}
+
+void FEmpathStatsCsvWriter::WriteFrame(float DeltaTime)
+{
+	if (!CsvArchive)
+	{
+		return;
+	}
+
+	// Frame timings are always available
+	WriteRow(TEXT("Frame"), TEXT("DeltaTimeMs"), DeltaTime * 1000.0f);
+	WriteRow(TEXT("Frame"), TEXT("GameThreadMs"), FPlatformTime::ToMilliseconds(GGameThreadTime));
+	WriteRow(TEXT("Frame"), TEXT("RenderThreadMs"), FPlatformTime::ToMilliseconds(GRenderThreadTime));
+
+#if STATS
+	// Write everything from the active stat groups
+	const FGameThreadStatsData* StatsData = FLatestGameThreadStatsData::Get().Latest;
+	if (StatsData)
+	{
+		for (int32 GroupIdx = 0; GroupIdx < StatsData->ActiveStatGroups.Num() && GroupIdx < StatsData->GroupNames.Num(); ++GroupIdx)
+		{
+			const FActiveStatGroupInfo& GroupInfo = StatsData->ActiveStatGroups[GroupIdx];
+			const FString GroupName = StatsData->GroupNames[GroupIdx].ToString();
+
+			for (const FComplexStatMessage& StatMessage : GroupInfo.FlatAggregate)
+			{
+				if (StatMessage.NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+				{
+					WriteRow(*GroupName, StatMessage.GetShortName().ToString(), FPlatformTime::ToMilliseconds(StatMessage.GetValue_Duration(EComplexStatField::IncAve)));
+				}
+			}
+
+			for (const FComplexStatMessage& StatMessage : GroupInfo.CountersAggregate)
+			{
+				const EStatDataType::Type DataType = StatMessage.NameAndInfo.GetField<EStatDataType>();
+				if (DataType == EStatDataType::ST_int64)
+				{
+					WriteRow(*GroupName, StatMessage.GetShortName().ToString(), (double)StatMessage.GetValue_int64(EComplexStatField::IncAve));
+				}
+				else if (DataType == EStatDataType::ST_double)
+				{
+					WriteRow(*GroupName, StatMessage.GetShortName().ToString(), StatMessage.GetValue_double(EComplexStatField::IncAve));
+				}
+			}
+		}
+	}
+#endif
+
+	FramesWritten++;
+}
+
+bool FEmpathStatsCsvWriter::IsStatGroupActive(FName const StatGroup)
+{
+#if STATS
+	const FGameThreadStatsData* StatsData = FLatestGameThreadStatsData::Get().Latest;
+	if (StatsData)
+	{
+		// The stat command registers groups with their STATGROUP_ prefix
+		const FName PrefixedGroup = FName(*(FString(TEXT("STATGROUP_")) + StatGroup.ToString()));
+		return StatsData->GroupNames.Contains(PrefixedGroup) || StatsData->GroupNames.Contains(StatGroup);
+	}
+#endif
+	return false;
+}
+
+void FEmpathStatsCsvWriter::WriteRow(const TCHAR* Group, const FString& Stat, double Value)
+{
+	const FString Row = FString::Printf(TEXT("%u,%s,%s,%f\n"), FramesWritten, Group, *Stat, Value);
+	FTCHARToUTF8 RowUTF8(*Row);
+	CsvArchive->Serialize((UTF8CHAR*)RowUTF8.Get(), RowUTF8.Length());
+}
@@ -0,0 +1,198 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/ConstraintInstance.h"
+#include "EmpathCharacter.h"
+#include "EmpathTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmpathCharacterPhysicsStateTransitionTest, "Empath.Character.PhysicsStateTransitionsMatchFullApply", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace EmpathPhysicsStateTests
+{
+	/** The parts of the mesh's physics state that a physics state preset sets. */
+	struct FBodiesSnapshot
+	{
+		bool bMeshSimulate;
+		bool bBlendPhysics;
+		TArray<bool> BodySimulate;
+		TArray<bool> BodyGravity;
+		TArray<FConstraintProfileProperties> ConstraintProfiles;
+	};
+
+	static FBodiesSnapshot TakeSnapshot(USkeletalMeshComponent const* Mesh)
+	{
+		FBodiesSnapshot Snapshot;
+		Snapshot.bMeshSimulate = Mesh->BodyInstance.bSimulatePhysics;
+		Snapshot.bBlendPhysics = Mesh->bBlendPhysics;
+		for (FBodyInstance const* BI : Mesh->Bodies)
+		{
+			Snapshot.BodySimulate.Add(BI && BI->IsInstanceSimulatingPhysics());
+			Snapshot.BodyGravity.Add(BI && BI->bEnableGravity);
+		}
+		for (FConstraintInstance const* ConstraintInstance : Mesh->Constraints)
+		{
+			Snapshot.ConstraintProfiles.Add(ConstraintInstance ? ConstraintInstance->ProfileInstance : FConstraintProfileProperties());
+		}
+		return Snapshot;
+	}
+
+	/** Finds every character blueprint in the project. */
+	static TArray<UClass*> FindCharacterClasses()
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.SearchAllAssets(true);
+
+		TArray<FName> BaseClassNames;
+		BaseClassNames.Add(AEmpathCharacter::StaticClass()->GetFName());
+		TSet<FName> DerivedClassNames;
+		AssetRegistry.GetDerivedClassNames(BaseClassNames, TSet<FName>(), DerivedClassNames);
+
+		TArray<FAssetData> Blueprints;
+		AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetFName(), Blueprints, true);
+
+		TArray<UClass*> CharacterClasses;
+		for (FAssetData const& Blueprint : Blueprints)
+		{
+			FString GeneratedClassPath;
+			if (Blueprint.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+			{
+				FString const ClassObjectPath = FPackageName::ExportTextPathToObjectPath(GeneratedClassPath);
+				if (DerivedClassNames.Contains(FName(*FPackageName::ObjectPathToObjectName(ClassObjectPath))))
+				{
+					UClass* const CharacterClass = LoadClass<AEmpathCharacter>(nullptr, *ClassObjectPath);
+					if (CharacterClass && !CharacterClass->HasAnyClassFlags(CLASS_Abstract))
+					{
+						CharacterClasses.Add(CharacterClass);
+					}
+				}
+			}
+		}
+		return CharacterClasses;
+	}
+}
+
+bool FEmpathCharacterPhysicsStateTransitionTest::RunTest(const FString& Parameters)
+{
+	using namespace EmpathPhysicsStateTests;
+
+	TArray<UClass*> const CharacterClasses = FindCharacterClasses();
+	int32 NumTestedClasses = 0;
+
+	for (UClass* const CharacterClass : CharacterClasses)
+	{
+		FEmpathTestWorld TestWorld(TEXT("EmpathPhysicsStateWorld"));
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AEmpathCharacter* const Character = TestWorld.GetWorld()->SpawnActor<AEmpathCharacter>(CharacterClass, FTransform(FVector(0.0f, 0.0f, 200.0f)), SpawnParams);
+		if (!TestNotNull(FString::Printf(TEXT("%s spawned"), *CharacterClass->GetName()), Character))
+		{
+			continue;
+		}
+
+		// The test world never begins play, and BeginPlay is where the presets are set up
+		if (!Character->HasActorBegunPlay())
+		{
+			Character->DispatchBeginPlay();
+		}
+
+		USkeletalMeshComponent* const MyMesh = Character->GetMesh();
+		if (!Character->ResolvePhysicsStates() || Character->PhysicsStateToSettingsMap.Num() < 2)
+		{
+			continue;
+		}
+		UPhysicsAsset* const PhysAsset = MyMesh->GetPhysicsAsset();
+		NumTestedClasses++;
+
+		int32 const NumStates = Character->ResolvedPhysicsStates.Num();
+		for (int32 FromIdx = 0; FromIdx < NumStates; ++FromIdx)
+		{
+			FEmpathCharPhysicsStateSettings const* const FromSettings = Character->PhysicsStateToSettingsMap.Find((EEmpathCharacterPhysicsState)FromIdx);
+			for (int32 ToIdx = 0; ToIdx < NumStates; ++ToIdx)
+			{
+				FEmpathCharPhysicsStateSettings const* const ToSettings = Character->PhysicsStateToSettingsMap.Find((EEmpathCharacterPhysicsState)ToIdx);
+				if (!FromSettings || !ToSettings || FromIdx == ToIdx)
+				{
+					continue;
+				}
+
+				// Each case starts from freshly created bodies, so bodies neither state touches have the same history.
+				// Legacy path, every setting of both states applied in full
+				Character->CurrentCharacterPhysicsState = (EEmpathCharacterPhysicsState)FromIdx;
+				MyMesh->RecreatePhysicsState();
+				Character->ApplyPhysicsStateSettingsFull(*FromSettings);
+				Character->ApplyPhysicsStateSettingsFull(*ToSettings);
+				FBodiesSnapshot const ExpectedTransitioned = TakeSnapshot(MyMesh);
+
+				// Synced to the old state, then only the differences applied
+				Character->CurrentCharacterPhysicsState = (EEmpathCharacterPhysicsState)FromIdx;
+				MyMesh->RecreatePhysicsState();
+				Character->ReapplyCharacterPhysicsState();
+				TestTrue(FString::Printf(TEXT("%s %d: bodies synced"), *CharacterClass->GetName(), FromIdx), Character->bPhysicsStateBodiesInSync);
+				Character->SetCharacterPhysicsState((EEmpathCharacterPhysicsState)ToIdx);
+				FBodiesSnapshot const Transitioned = TakeSnapshot(MyMesh);
+
+				// Legacy path when the bodies are recreated between the two states
+				Character->CurrentCharacterPhysicsState = (EEmpathCharacterPhysicsState)FromIdx;
+				MyMesh->RecreatePhysicsState();
+				Character->ApplyPhysicsStateSettingsFull(*FromSettings);
+				MyMesh->RecreatePhysicsState();
+				Character->ApplyPhysicsStateSettingsFull(*ToSettings);
+				FBodiesSnapshot const ExpectedRecreated = TakeSnapshot(MyMesh);
+
+				// Synced to the old state, then the bodies are recreated behind our back before the change
+				Character->CurrentCharacterPhysicsState = (EEmpathCharacterPhysicsState)FromIdx;
+				MyMesh->RecreatePhysicsState();
+				Character->ReapplyCharacterPhysicsState();
+				MyMesh->RecreatePhysicsState();
+				TestFalse(FString::Printf(TEXT("%s %d: recreated bodies not synced"), *CharacterClass->GetName(), FromIdx), Character->bPhysicsStateBodiesInSync);
+				Character->SetCharacterPhysicsState((EEmpathCharacterPhysicsState)ToIdx);
+				FBodiesSnapshot const Recreated = TakeSnapshot(MyMesh);
+
+				FBodiesSnapshot const* const Results[] = { &Transitioned, &Recreated };
+				FBodiesSnapshot const* const Expectations[] = { &ExpectedTransitioned, &ExpectedRecreated };
+				TCHAR const* const ResultNames[] = { TEXT("transition"), TEXT("after recreate") };
+				for (int32 ResultIdx = 0; ResultIdx < ARRAY_COUNT(Results); ++ResultIdx)
+				{
+					FBodiesSnapshot const& Result = *Results[ResultIdx];
+					FBodiesSnapshot const& Expected = *Expectations[ResultIdx];
+					FString const Context = FString::Printf(TEXT("%s %d -> %d %s"), *CharacterClass->GetName(), FromIdx, ToIdx, ResultNames[ResultIdx]);
+					TestTrue(FString::Printf(TEXT("%s: mesh simulate"), *Context), Result.bMeshSimulate == Expected.bMeshSimulate);
+					TestTrue(FString::Printf(TEXT("%s: blend physics"), *Context), Result.bBlendPhysics == Expected.bBlendPhysics);
+					if (!TestEqual(FString::Printf(TEXT("%s: body count"), *Context), Result.BodySimulate.Num(), Expected.BodySimulate.Num())
+						|| !TestEqual(FString::Printf(TEXT("%s: constraint count"), *Context), Result.ConstraintProfiles.Num(), Expected.ConstraintProfiles.Num()))
+					{
+						continue;
+					}
+
+					for (int32 BodyIdx = 0; BodyIdx < Expected.BodySimulate.Num(); ++BodyIdx)
+					{
+						FName const BoneName = PhysAsset->SkeletalBodySetups[BodyIdx] ? PhysAsset->SkeletalBodySetups[BodyIdx]->BoneName : NAME_None;
+						TestTrue(FString::Printf(TEXT("%s: %s simulate"), *Context, *BoneName.ToString()), Result.BodySimulate[BodyIdx] == Expected.BodySimulate[BodyIdx]);
+						TestTrue(FString::Printf(TEXT("%s: %s gravity"), *Context, *BoneName.ToString()), Result.BodyGravity[BodyIdx] == Expected.BodyGravity[BodyIdx]);
+					}
+					for (int32 ConstraintIdx = 0; ConstraintIdx < Expected.ConstraintProfiles.Num(); ++ConstraintIdx)
+					{
+						bool const bSameProfile = FConstraintProfileProperties::StaticStruct()->CompareScriptStruct(&Result.ConstraintProfiles[ConstraintIdx], &Expected.ConstraintProfiles[ConstraintIdx], PPF_None);
+						TestTrue(FString::Printf(TEXT("%s: constraint %d profile"), *Context, ConstraintIdx), bSameProfile);
+					}
+				}
+			}
+		}
+	}
+
+	if (NumTestedClasses == 0)
+	{
+		AddWarning(TEXT("No character blueprints with a physics asset and at least two physics states were found, nothing was compared"));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,120 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "EmpathEnvQueryTest_Dot.h"
+#include "EnvironmentQuery/EnvQuery.h"
+#include "EnvironmentQuery/EnvQueryOption.h"
+#include "EnvironmentQuery/EnvQueryManager.h"
+#include "EnvironmentQuery/Generators/EnvQueryGenerator_SimpleGrid.h"
+#include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
+#include "EnvironmentQuery/Contexts/EnvQueryContext_Item.h"
+#include "Engine/TargetPoint.h"
+#include "EmpathTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEmpathEnvQueryTestDotBatchedTest, "Empath.AI.EQS.DotTestBatchedMatchesPerItem", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace EmpathDotTestTests
+{
+	/** Runs a query and returns the score of each item, keyed by the item's location. */
+	static TMap<FVector, float> RunQuery(UEnvQueryManager* EQSManager, UEnvQuery* Query, UObject* Querier)
+	{
+		TMap<FVector, float> Scores;
+		FEnvQueryRequest Request(Query, Querier);
+		TSharedPtr<FEnvQueryResult> Result = EQSManager->RunInstantQuery(Request, EEnvQueryRunMode::AllMatching);
+		if (Result.IsValid())
+		{
+			for (int32 ItemIdx = 0; ItemIdx < Result->Items.Num(); ++ItemIdx)
+			{
+				Scores.Add(Result->GetItemAsLocation(ItemIdx), Result->GetItemScore(ItemIdx));
+			}
+		}
+		return Scores;
+	}
+}
+
+bool FEmpathEnvQueryTestDotBatchedTest::RunTest(const FString& Parameters)
+{
+	FEmpathTestWorld TestWorld(TEXT("EmpathDotTestWorld"));
+	UWorld* const World = TestWorld.GetWorld();
+	UEnvQueryManager* const EQSManager = UEnvQueryManager::GetCurrent(World);
+	if (!TestNotNull(TEXT("EQS manager"), EQSManager))
+	{
+		return false;
+	}
+
+	// The querier looks slightly down and to the side so that 2D and 3D results differ
+	ATargetPoint* const Querier = World->SpawnActor<ATargetPoint>(FVector(120.0f, -40.0f, 80.0f), FRotator(-15.0f, 30.0f, 0.0f));
+	if (!TestNotNull(TEXT("Querier"), Querier))
+	{
+		return false;
+	}
+
+	IConsoleVariable* const BatchedVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Empath.EQSDotBatched"));
+	if (!TestNotNull(TEXT("Empath.EQSDotBatched"), BatchedVar))
+	{
+		return false;
+	}
+	int32 const PrevBatched = BatchedVar->GetInt();
+
+	// Cover both test modes, absolute values, and lines that are shared by all items as well as lines that are per item
+	EEnvTestDot::Type const TestModes[] = { EEnvTestDot::Dot3D, EEnvTestDot::Dot2D };
+	for (EEnvTestDot::Type const TestMode : TestModes)
+	{
+		for (int32 AbsoluteIdx = 0; AbsoluteIdx < 2; ++AbsoluteIdx)
+		{
+			for (int32 PerItemLineAIdx = 0; PerItemLineAIdx < 2; ++PerItemLineAIdx)
+			{
+				// Each configuration needs its own query, since the EQS manager caches a copy of each query by name
+				UEnvQuery* const Query = NewObject<UEnvQuery>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UEnvQuery::StaticClass(), TEXT("EmpathDotTestQuery")));
+				UEnvQueryOption* const Option = NewObject<UEnvQueryOption>(Query);
+				UEnvQueryGenerator_SimpleGrid* const Generator = NewObject<UEnvQueryGenerator_SimpleGrid>(Option);
+				Generator->GridSize.DefaultValue = 1000.0f;
+				Generator->SpaceBetween.DefaultValue = 100.0f;
+				Generator->ProjectionData.TraceMode = EEnvQueryTrace::None;
+				Option->Generator = Generator;
+
+				UEmpathEnvQueryTest_Dot* const DotTest = NewObject<UEmpathEnvQueryTest_Dot>(Option);
+				DotTest->TestMode = TestMode;
+				DotTest->bAbsoluteValue = (AbsoluteIdx != 0);
+				if (PerItemLineAIdx != 0)
+				{
+					DotTest->LineA.DirMode = EEnvDirection::TwoPoints;
+					DotTest->LineA.LineFrom = UEnvQueryContext_Item::StaticClass();
+					DotTest->LineA.LineTo = UEnvQueryContext_Querier::StaticClass();
+				}
+				DotTest->TestOrder = 0;
+				Option->Tests.Add(DotTest);
+				Query->GetOptionsMutable().Add(Option);
+
+				BatchedVar->Set(0);
+				TMap<FVector, float> const PerItemScores = EmpathDotTestTests::RunQuery(EQSManager, Query, Querier);
+				BatchedVar->Set(1);
+				TMap<FVector, float> const BatchedScores = EmpathDotTestTests::RunQuery(EQSManager, Query, Querier);
+
+				FString const Config = FString::Printf(TEXT("%s%s%s"),
+					TestMode == EEnvTestDot::Dot3D ? TEXT("Dot3D") : TEXT("Dot2D"),
+					AbsoluteIdx != 0 ? TEXT(" Absolute") : TEXT(""),
+					PerItemLineAIdx != 0 ? TEXT(" PerItemLineA") : TEXT(""));
+				TestTrue(FString::Printf(TEXT("%s: query returned items"), *Config), PerItemScores.Num() > 0);
+				TestEqual(FString::Printf(TEXT("%s: item count"), *Config), BatchedScores.Num(), PerItemScores.Num());
+				for (TPair<FVector, float> const& PerItemScore : PerItemScores)
+				{
+					float const* const BatchedScore = BatchedScores.Find(PerItemScore.Key);
+					if (TestNotNull(FString::Printf(TEXT("%s: item %s scored"), *Config, *PerItemScore.Key.ToString()), BatchedScore))
+					{
+						TestEqual(FString::Printf(TEXT("%s: item %s score"), *Config, *PerItemScore.Key.ToString()), *BatchedScore, PerItemScore.Value, KINDA_SMALL_NUMBER);
+					}
+				}
+			}
+		}
+	}
+
+	BatchedVar->Set(PrevBatched);
+	return true;
+}
+
+#endif
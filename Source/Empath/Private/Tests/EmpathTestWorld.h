@@ -0,0 +1,48 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "AI/Navigation/NavigationSystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+* Creates a game world with navigation and AI for automation tests, and destroys it when it goes out of scope.
+*/
+class FEmpathTestWorld
+{
+public:
+	FEmpathTestWorld(const TCHAR* WorldName)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, FName(WorldName));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		// Game worlds are not always created with navigation or AI
+		if (!World->GetNavigationSystem())
+		{
+			UNavigationSystem::CreateNavigationSystem(World);
+		}
+		if (!World->GetAISystem())
+		{
+			World->CreateAISystem();
+		}
+		World->InitializeActorsForPlay(FURL());
+	}
+
+	~FEmpathTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UWorld* GetWorld() const { return World; }
+
+private:
+	UWorld* World;
+};
+
+#endif
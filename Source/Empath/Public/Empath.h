@@ -3,3 +3,6 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+// Stat group for the hot paths of the Empath module, so they can be viewed together with "stat EMPATH"
+DECLARE_STATS_GROUP(TEXT("Empath"), STATGROUP_EMPATH, STATCAT_Advanced);
@@ -0,0 +1,52 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "EmpathAIBenchmarkCommandlet.generated.h"
+
+class UWorld;
+class AEmpathAIManager;
+class AEmpathAIController;
+
+/**
+* Headless stress test for the AI stack. Generates an arena with a navmesh, spawns a crowd of AI characters with seeded behavior
+* around a moving fake player target, simulates a fixed number of ticks, and writes frame time percentiles,
+* per-subsystem costs (targeting, vision, noise, EQS, pathing), and allocation counts to a JSON file.
+* Fails without writing results if the navmesh ends up with no tiles.
+*
+* Usage: UE4Editor-Cmd Empath -run=EmpathAIBenchmark [-Characters=64] [-Ticks=600] [-Seed=1234] [-DeltaTime=0.0166]
+*		[-ArenaSize=6000] [-Obstacles=40] [-CharacterClass=/Game/Path/BP_Enemy.BP_Enemy_C] [-Query=/Game/Path/EQS_Query.EQS_Query]
+*		[-NoisesPerTick=2] [-PathsPerTick=8] [-QueriesPerTick=4] [-Output=AIBenchmark.json]
+*/
+UCLASS()
+class EMPATH_API UEmpathAIBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UEmpathAIBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Timing samples for one subsystem, one per simulated tick, in milliseconds. */
+	struct FSubsystemSamples
+	{
+		FString Name;
+		TArray<double> Samples;
+		int32 Calls;
+
+		FSubsystemSamples(const FString& InName) : Name(InName), Calls(0) {}
+	};
+
+	/** Builds the floor and seeded obstacles, then generates the navmesh for them. */
+	void BuildArena(UWorld* World, FRandomStream& Random, float ArenaSize, int32 NumObstacles) const;
+
+	/** Returns the given percentile of a set of samples. Sorts the samples. */
+	static double GetPercentile(TArray<double>& Samples, float Percentile);
+
+	/** Writes the percentiles for a set of samples as a JSON object. */
+	static FString SamplesToJson(TArray<double>& Samples);
+};
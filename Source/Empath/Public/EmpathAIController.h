@@ -29,6 +29,10 @@ UCLASS()
 class EMPATH_API AEmpathAIController : public AVRAIController, public IEmpathTeamAgentInterface
 {
 	GENERATED_BODY()
+
+	// The AI benchmark times the targeting and vision updates directly
+	friend class UEmpathAIBenchmarkCommandlet;
+
 public:
 
 	// ---------------------------------------------------------
@@ -55,6 +59,16 @@ public:
 	/** Returns whether we have registered with the AI Manager. */
 	bool IsRegisteredWithAIManager() { return (AIManager != nullptr); }
 
+	/** Deactivates this controller along with its character when the character is stored in the character pool. */
+	virtual void OnReturnedToPool();
+
+	/** Restores this controller to its freshly spawned state when its character is taken from the character pool. */
+	virtual void ResetFromPool();
+
+	/** Called when our character is taken from the character pool, so that blueprints can reset any state of their own. */
+	UFUNCTION(BlueprintImplementableEvent, Category = EmpathAIController, meta = (DisplayName = "On Reset From Pool"))
+	void ReceiveResetFromPool();
+
 
 	// ---------------------------------------------------------
 	//	TeamAgent Interface
@@ -15,6 +15,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNewPlayerAwarenessStateDelegate,
 
 // Forward declarations
 class AEmpathAIController;
+class AEmpathCharacter;
 class AEmpathPlayerCharacter;
 
 
@@ -26,6 +27,9 @@ class EMPATH_API AEmpathAIManager : public AActor
 public:
 	static const float HearingDisconnectDist;
 
+	/** Distance that counts as much as one second of simulation time when choosing which ragdolls to freeze first. */
+	static const float RagdollEvictionDistanceScale;
+
 	// Sets default values for this actor's properties
 	AEmpathAIManager();
 
@@ -91,6 +95,48 @@ public:
 	/** Called when the player awareness state changes */
 	FOnNewPlayerAwarenessStateDelegate OnNewPlayerAwarenessState;
 
+	/** Adds a dead, simulating ragdoll to the ragdoll LOD and simulation budget. */
+	void RegisterDeadRagdoll(AEmpathCharacter* DeadCharacter);
+
+	/** Removes a dead ragdoll from the ragdoll LOD. */
+	void UnregisterDeadRagdoll(AEmpathCharacter* DeadCharacter);
+
+	/** Freezes and snapshots dead ragdolls as appropriate, and enforces the simulating ragdoll budget. */
+	void UpdateRagdollLOD();
+
+	/** 
+	* Spawns a character of the given class along with its AI controller, reusing a pooled character if one is available.
+	* Characters spawned this way are returned to the pool after death instead of being destroyed.
+	*/
+	UFUNCTION(BlueprintCallable, Category = EmpathAIManager)
+	AEmpathCharacter* SpawnPooledCharacter(TSubclassOf<AEmpathCharacter> CharacterClass, FTransform const& SpawnTransform);
+
+	/** Deactivates the character and stores it in the pool for reuse. Returns false if the pool is full or disabled, in which case the character should be destroyed. */
+	bool ReleaseCharacterToPool(AEmpathCharacter* Character);
+
+	/** Spawns characters of the given class directly into the pool until it holds at least Count of them. */
+	UFUNCTION(BlueprintCallable, Category = EmpathAIManager)
+	void PrewarmCharacterPool(TSubclassOf<AEmpathCharacter> CharacterClass, int32 Count);
+
+	/** Returns the number of characters of the given class currently waiting in the pool. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = EmpathAIManager)
+	int32 GetNumPooledCharacters(TSubclassOf<AEmpathCharacter> CharacterClass) const;
+
+	/** Returns the player location context for EQS queries, resolved at most once per frame for all AIs. Returns false if there is no player. */
+	bool GetQueryContextPlayerLocation(FVector& OutLocation);
+
+	/** Clears the cached player location EQS context. */
+	void InvalidateQueryContextCache();
+
+	/** Queues a nav recovery check for the character. Checks are started under a shared per frame budget, nearest to the player first. */
+	void RequestNavRecoveryQuery(AEmpathCharacter* Character);
+
+	/** Removes the character's nav recovery check from the queue if it has not started yet. */
+	void CancelNavRecoveryQuery(AEmpathCharacter* Character);
+
+	/** Starts as many queued nav recovery checks as the budget allows this frame. */
+	void UpdateNavRecoveryQueries();
+
 protected:
 	/** How long the AI has to find the player after teleporting before declaring him "lost", in seconds. */
 	float LostPlayerTimeThreshold;
@@ -110,8 +156,31 @@ protected:
 	FVector LastKnownPlayerLocation;
 	FTimerHandle LostPlayerTimerHandle;
 
+	/** How often we update the ragdoll LOD, in seconds. */
+	float RagdollLODUpdateInterval;
+	FTimerHandle RagdollLODTimerHandle;
+
+	/** Dead characters whose ragdolls are managed by the ragdoll LOD. */
+	UPROPERTY(Transient)
+	TArray<AEmpathCharacter*> DeadRagdolls;
+
+	/** Inactive characters waiting to be reused by SpawnPooledCharacter. */
+	UPROPERTY(Transient)
+	TArray<AEmpathCharacter*> PooledCharacters;
+
+	/** Characters waiting for their nav recovery check to be started. */
+	UPROPERTY(Transient)
+	TArray<AEmpathCharacter*> NavRecoveryQueue;
+
+	/** Player location EQS context cached for the current frame. */
+	FVector QueryContextPlayerLocation;
+	uint64 QueryContextPlayerLocationFrame;
+
 
 private:
+	/** Spawns a new character and controller for the pool. */
+	AEmpathCharacter* SpawnNewPooledCharacter(TSubclassOf<AEmpathCharacter> CharacterClass, FTransform const& SpawnTransform);
+
 	/** Removes any stale or dead secondary AI cons from the list. */
 	void CleanUpSecondaryTargets();
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "EmpathTeamAgentInterface.h"
 #include "GameFramework/Character.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "AI/Navigation/NavigationTypes.h"
 #include "EmpathTypes.h"
 #include "EmpathCharacter.generated.h"
 
@@ -21,6 +22,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCharacterStunEndDelegate);
 class AEmpathAIController;
 class UDamageType;
 class UPhysicalAnimationComponent;
+class UPhysicsAsset;
 class ANavigationData;
 
 UCLASS()
@@ -294,6 +296,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "EmpathCharacter|Physics")
 	bool SetCharacterPhysicsState(EEmpathCharacterPhysicsState NewState);
 
+	/** Reapplies every setting of the current physics state preset.
+	Call this after changing the mesh's bodies directly, such as through SetAllBodiesBelowSimulatePhysics or physical animation,
+	since later calls to SetCharacterPhysicsState only apply what differs between presets. */
+	UFUNCTION(BlueprintCallable, Category = "EmpathCharacter|Physics")
+	void ReapplyCharacterPhysicsState();
+
 
 	// ---------------------------------------------------------
 	//	Ragdoll handling
@@ -343,6 +351,59 @@ public:
 	void TickUpdateRagdollRecoveryState();
 
 
+	// ---------------------------------------------------------
+	//	Ragdoll LOD
+
+	/** Whether our ragdoll should be managed by the AI Manager's ragdoll LOD after death. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EmpathCharacter|Physics")
+	bool bUseRagdollLOD;
+
+	/** Distance from the player beyond which our dead ragdoll will be frozen once it is at rest. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EmpathCharacter|Physics")
+	float RagdollLODFreezeDistance;
+
+	/** How long our dead ragdoll must go unrendered before it will be frozen once it is at rest. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EmpathCharacter|Physics")
+	float RagdollLODOffscreenTime;
+
+	/** How long after being frozen that our dead ragdoll is converted to a static pose snapshot. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "EmpathCharacter|Physics")
+	float RagdollLODSnapshotDelay;
+
+	/** Returns the current LOD state of our ragdoll. */
+	UFUNCTION(BlueprintCallable, Category = "EmpathCharacter|Physics")
+	EEmpathRagdollLODState GetRagdollLODState() const { return RagdollLODState; }
+
+	/** Returns the last time our ragdoll LOD state changed. */
+	float GetRagdollLODStateStartTime() const { return RagdollLODStateStartTime; }
+
+	/** Stops simulating our dead ragdoll and holds it in its current pose. Returns whether the ragdoll was frozen. */
+	UFUNCTION(BlueprintCallable, Category = "EmpathCharacter|Physics")
+	bool FreezeRagdoll();
+
+	/** Removes the collision and ticking of our frozen ragdoll, leaving the mesh in the pose it was frozen in. Returns whether the ragdoll was converted. */
+	UFUNCTION(BlueprintCallable, Category = "EmpathCharacter|Physics")
+	bool SnapshotRagdollPose();
+
+
+	// ---------------------------------------------------------
+	//	Pooling
+
+	/** Whether this character was spawned through the AI Manager's character pool, and should be returned to it instead of destroyed. */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "EmpathCharacter|Pooling")
+	bool bManagedByCharacterPool;
+
+	/** Deactivates this character so that it can be stored in the character pool. */
+	virtual void OnReturnedToPool();
+
+	/** Restores this character to its freshly spawned state when it is taken from the character pool. */
+	virtual void ResetFromPool();
+
+	/** Called when this character is taken from the character pool, so that blueprints can reset any state of their own. */
+	UFUNCTION(BlueprintImplementableEvent, Category = "EmpathCharacter|Pooling", meta = (DisplayName = "On Reset From Pool"))
+	void ReceiveResetFromPool();
+
+
 	// ---------------------------------------------------------
 	//	Movement
 
@@ -535,6 +596,15 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "EmpathCharacter|NavMeshRecovery", meta = (DisplayName = "On Tick Nav Mesh Recovery"))
 	void ReceiveTickNavMeshRecovery(float DeltaTime, FVector Location, FVector RecoveryDestination);
 
+	/** Runs our check for whether we have recovered the navmesh. Called by the AI Manager's nav recovery scheduler when there is budget, or immediately if there is no AI Manager. */
+	void StartNavRecoveryQuery();
+
+	/** Called with the result of our nav recovery check. */
+	void OnNavRecoveryQueryComplete(bool bRecovered, FVector ProjectedPoint);
+
+	/** Returns whether a nav recovery check is currently queued or in flight. */
+	bool IsNavRecoveryQueryPending() const { return bNavRecoveryQueryPending; }
+
 	/** Called when we failed to find a recovery destination. */
 	virtual void OnNavMeshRecoveryFailed(FVector Location, float TimeSinceStartRecovery);
 
@@ -647,9 +717,55 @@ private:
 	/** Whether the character has been signaled to get up from ragdoll. */
 	bool bDeferredGetUpFromRagdoll;
 
+	/** Current LOD state of our ragdoll. */
+	EEmpathRagdollLODState RagdollLODState;
+
+	/** The time our ragdoll entered its current LOD state. */
+	float RagdollLODStateStartTime;
+
 	/** Stored reference to our control Empath AI controller */
 	AEmpathAIController* CachedEmpathAICon;
 
 	/** Map of physics states to settings for faster lookup */
 	TMap<EEmpathCharacterPhysicsState, FEmpathCharPhysicsStateSettings> PhysicsStateToSettingsMap;
+
+	/** Physics state presets resolved against our current physics asset, indexed by physics state. */
+	TArray<FEmpathResolvedPhysicsState> ResolvedPhysicsStates;
+
+	/** Precomputed changes between each pair of resolved physics states, indexed by (From * ResolvedPhysicsStates.Num()) + To. */
+	TArray<FEmpathPhysicsStateTransition> PhysicsStateTransitions;
+
+	/** The physics asset our physics states were resolved against. */
+	TWeakObjectPtr<UPhysicsAsset> ResolvedPhysicsAsset;
+
+	/** Whether our bodies are known to match the resolved settings of the current physics state.
+	* Cleared whenever the bodies are changed outside of SetCharacterPhysicsState, so the next transition reapplies everything. */
+	bool bPhysicsStateBodiesInSync;
+
+	/** Called when the mesh's physics state is created. Its bodies are back to their defaults, so they no longer match our physics state. */
+	void OnMeshPhysicsCreated();
+
+	/** Resolves our physics state presets against the current physics asset and precomputes the transitions between them. 
+	Returns false if the mesh has no bodies to resolve against. */
+	bool ResolvePhysicsStates();
+
+	/** Applies every setting of a physics state to the whole mesh. */
+	void ApplyPhysicsStateSettingsFull(FEmpathCharPhysicsStateSettings const& NewSettings);
+
+	/** Applies only the bodies and constraints that change between two resolved physics states. */
+	void ApplyPhysicsStateTransition(EEmpathCharacterPhysicsState OldState, EEmpathCharacterPhysicsState NewState);
+
+	/** Whether a nav recovery check is currently queued or in flight. */
+	bool bNavRecoveryQueryPending;
+
+	/** ID of our in flight async nav recovery path query, or INVALID_NAVQUERYID. */
+	uint32 NavRecoveryPathQueryID;
+
+	/** Called when our async nav recovery path query completes. */
+	void OnNavRecoveryPathQueryComplete(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	/** Cancels any queued or in flight nav recovery check. */
+	void CancelNavRecoveryQuery();
+
+	friend class FEmpathCharacterPhysicsStateTransitionTest;
 };
\ No newline at end of file
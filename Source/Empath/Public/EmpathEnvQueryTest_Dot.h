@@ -19,6 +19,8 @@ class UEmpathEnvQueryTest_Dot : public UEnvQueryTest
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class FEmpathEnvQueryTestDotBatchedTest;
+
 public:
 	UPROPERTY(EditDefaultsOnly, Category = Dot)
 		bool bUseCamRotInsteadOfPlayerIn360TrackingMode;
@@ -61,4 +63,15 @@ protected:
 
 	/** helper function: check if contexts are updated per item */
 	bool RequiresPerItemUpdates(TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo, TSubclassOf<UEnvQueryContext> LineDirection, bool bUseDirectionContext) const;
+
+	/** helper function: check if the test can be scored in a single batch over all items, i.e. no line needs per item rotations */
+	bool CanRunBatched(bool bUpdateLineAPerItem, bool bUpdateLineBPerItem) const;
+
+	/** fast path: gathers all item directions into contiguous buffers, computes every dot product in one pass, then writes the scores back */
+	void RunTestBatched(FEnvQueryInstance& QueryInstance, const TArray<FVector>& LineADirs, const TArray<FVector>& LineBDirs,
+		bool bUpdateLineAPerItem, bool bUpdateLineBPerItem, float MinThresholdValue, float MaxThresholdValue) const;
+
+	/** helper function: gather directions between two contexts for every item at once, stored contiguously per item */
+	void GatherLineDirectionsBatched(TArray<FVector>& Directions, int32& NumDirectionsPerItem, FEnvQueryInstance& QueryInstance, const TArray<FVector>& ItemLocations,
+		TSubclassOf<UEnvQueryContext> LineFrom, TSubclassOf<UEnvQueryContext> LineTo) const;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "EmpathTypes.h"
 #include "EmpathGameModeBase.generated.h"
 
 class AEmpathAIManager;
@@ -23,6 +24,11 @@ public:
 	AEmpathAIManager* GetAIManager() const { return AIManager; }
 
 	virtual void BeginPlay() override;
+
+	/** Characters to pre-spawn into the AI Manager's character pool when the level loads. */
+	UPROPERTY(EditDefaultsOnly, Category = EmpathGameMode)
+	TArray<FEmpathCharacterPoolPrewarm> CharacterPoolPrewarm;
+
 private:
 	AEmpathAIManager* AIManager;
 	
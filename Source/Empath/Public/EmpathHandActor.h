@@ -97,7 +97,7 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "EmpathHandActor|Gripping")
 	AActor* HeldObject;
 
-	/** Gets the nearest Actor overlapping the grip collision. */
+	/** Gets the nearest Actor overlapping the grip collision. Only scores the cached grip candidates, so does not allocate. */
 	UFUNCTION(BlueprintCallable, Category = "EmpathHandActor|Gripping")
 	void GetBestGripCandidate(AActor*& GripActor, UPrimitiveComponent*& GripComponent, EEmpathGripType& GripResponse);
 
@@ -134,6 +134,14 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	/** Adds grippable components to the grip candidates when they start overlapping the grip collision. */
+	UFUNCTION()
+	void OnGripCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Removes components from the grip candidates when they stop overlapping the grip collision. */
+	UFUNCTION()
+	void OnGripCollisionEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
 
 private:
 
@@ -194,5 +202,21 @@ private:
 	// The current grip state of this hand.
 	UPROPERTY(Category = EmpathHandActor, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	EEmpathGripType GripState;
+
+	/** A component overlapping the grip collision whose owner implements the grip object interface. */
+	struct FGripCandidate
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		TWeakObjectPtr<AActor> Actor;
+
+		FGripCandidate(UPrimitiveComponent* InComponent, AActor* InActor) : Component(InComponent), Actor(InActor) {}
+	};
+
+	/** Components currently overlapping the grip collision that can respond to grips.
+	* Updated from the overlap events so we only do the interface check once per overlap, rather than on every grip query. */
+	TArray<FGripCandidate> GripCandidates;
+
+	/** Adds a component to the grip candidates if its owner implements the grip object interface. */
+	void AddGripCandidate(UPrimitiveComponent* Component);
 	
 };
@@ -0,0 +1,145 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputCoreTypes.h"
+#include "EmpathTypes.h"
+#include "EmpathStatsCsvWriter.h"
+#include "EmpathInputRecorderComponent.generated.h"
+
+class APlayerController;
+class AVRBaseCharacter;
+
+// This component records the HMD and controller transforms, key and axis events, and frame delta of its owning player controller
+// to a compact binary file, and can play that file back to drive the controlled pawn without an HMD (ie: under -nullrhi)
+// so that VR sessions can be reproduced for performance testing.
+
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class EMPATH_API UEmpathInputRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this component's properties
+	UEmpathInputRecorderComponent();
+
+	// Called every frame
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Starts recording to the given file. Relative paths are placed in the project's Saved/InputRecordings folder. */
+	UFUNCTION(BlueprintCallable, Category = EmpathInputRecorder)
+	bool StartRecording(const FString& FileName);
+
+	/** Stops recording and writes the recorded frames to disk. */
+	UFUNCTION(BlueprintCallable, Category = EmpathInputRecorder)
+	void StopRecording();
+
+	/** Starts playing back the given recording. If CsvFileName is not empty, per-frame stats are written to it while playing. */
+	UFUNCTION(BlueprintCallable, Category = EmpathInputRecorder)
+	bool StartPlayback(const FString& FileName, const FString& CsvFileName);
+
+	/** Stops playback and restores the normal timestep and tracking settings. */
+	UFUNCTION(BlueprintCallable, Category = EmpathInputRecorder)
+	void StopPlayback();
+
+	/** Whether we are currently recording. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = EmpathInputRecorder)
+	bool IsRecording() const { return bRecording; }
+
+	/** Whether we are currently playing back a recording. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = EmpathInputRecorder)
+	bool IsPlayingBack() const { return bPlayingBack; }
+
+	/** Adds a key event to the current frame if we are recording. */
+	void RecordKey(FKey Key, EInputEvent EventType, float AmountDepressed, bool bGamepad);
+
+	/** Adds an axis event to the current frame if we are recording. */
+	void RecordAxis(FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad);
+
+	/** If true, playback runs with a fixed timestep using the recorded frame deltas, so a recording always simulates the same way.
+	* Otherwise playback uses PlaybackFixedDeltaTime for every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = EmpathInputRecorder)
+	bool bUseRecordedDeltaTime;
+
+	/** The fixed timestep to use during playback when not using the recorded deltas. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = EmpathInputRecorder, meta = (EditCondition = "!bUseRecordedDeltaTime", ClampMin = "0.001", UIMin = "0.001"))
+	float PlaybackFixedDeltaTime;
+
+	/** Whether to request the application to exit when playback finishes. Used for automated runs. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = EmpathInputRecorder)
+	bool bExitWhenPlaybackFinished;
+
+	/** Stat groups to enable while writing the playback CSV. These are the names used by the stat command.
+	* Groups that are already on are left on, only the ones turned on for playback are turned off again afterwards. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = EmpathInputRecorder)
+	TArray<FName> CsvStatGroups;
+
+private:
+	/** Whether we are currently recording. */
+	bool bRecording;
+
+	/** Whether we are currently playing back a recording. */
+	bool bPlayingBack;
+
+	/** Full path of the file we are recording to. */
+	FString RecordingFilePath;
+
+	/** Names of every key in the current recording. Events reference keys by index into this table. */
+	TArray<FName> KeyNames;
+
+	/** Lookup from key name to index in the key name table, used while recording. */
+	TMap<FName, uint16> KeyNameIndices;
+
+	/** Frames of the current recording or playback. */
+	TArray<FEmpathRecordedInputFrame> Frames;
+
+	/** Events received since the last recorded frame. */
+	TArray<FEmpathRecordedInputEvent> PendingEvents;
+
+	/** The next frame to play back. */
+	int32 PlaybackFrameIndex;
+
+	/** Writes stats for each frame during playback. */
+	FEmpathStatsCsvWriter StatsCsvWriter;
+
+	/** The stat groups we turned on for the playback CSV. */
+	TArray<FName> EnabledCsvStatGroups;
+
+	/** Timestep settings to restore after playback. */
+	bool bPrePlaybackUseFixedTimeStep;
+	double PrePlaybackFixedDeltaTime;
+
+	/** Tracking settings to restore on the motion controllers after playback. */
+	bool bPrePlaybackLeftUseWithoutTracking;
+	bool bPrePlaybackRightUseWithoutTracking;
+
+	/** The pawn we are driving during playback. */
+	TWeakObjectPtr<AVRBaseCharacter> PlaybackCharacter;
+
+	/** Returns the owning player controller. */
+	APlayerController* GetOwningPlayerController() const;
+
+	/** Returns the VR character controlled by our owner, if any. */
+	AVRBaseCharacter* GetControlledVRCharacter() const;
+
+	/** Returns the index of a key in the key name table, adding it if necessary. */
+	uint16 GetKeyIndex(const FKey& Key);
+
+	/** Captures the current tracked transforms and pending events into a new frame. */
+	void RecordFrame(float DeltaTime);
+
+	/** Applies the next recorded frame to our controller and pawn. */
+	void PlayFrame();
+
+	/** Turns on any of the CSV stat groups that aren't already on. */
+	void EnableCsvStatGroups();
+
+	/** Turns off the stat groups that EnableCsvStatGroups turned on. */
+	void RestoreCsvStatGroups();
+
+	/** Returns the full path for a recording file name. */
+	static FString GetRecordingPath(const FString& FileName);
+};
@@ -6,6 +6,8 @@
 #include "GameFramework/PlayerController.h"
 #include "EmpathPlayerController.generated.h"
 
+class UEmpathInputRecorderComponent;
+
 /**
  * 
  */
@@ -15,6 +17,36 @@ class EMPATH_API AEmpathPlayerController : public APlayerController
 	GENERATED_BODY()
 	
 public:
+	// Constructor to set default variables
+	AEmpathPlayerController(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Override for begin play
+	virtual void BeginPlay() override;
+
+	// Input overrides so that input can be recorded and replayed
+	virtual bool InputKey(FKey Key, EInputEvent EventType, float AmountDepressed, bool bGamepad) override;
+	virtual bool InputAxis(FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad) override;
+
+	/** Records and replays VR input for performance testing. */
+	UPROPERTY(Category = EmpathPlayerController, VisibleAnywhere, BlueprintReadOnly)
+	UEmpathInputRecorderComponent* InputRecorder;
+
+	/** Starts recording VR input to the given file. */
+	UFUNCTION(Exec)
+	void EmpathRecordInput(const FString& FileName);
+
+	/** Stops recording VR input and saves the recording. */
+	UFUNCTION(Exec)
+	void EmpathStopRecordingInput();
+
+	/** Plays back a VR input recording, optionally writing per-frame stats to CsvFileName. */
+	UFUNCTION(Exec)
+	void EmpathReplayInput(const FString& FileName, const FString& CsvFileName);
+
+	/** Stops playing back VR input. */
+	UFUNCTION(Exec)
+	void EmpathStopReplayingInput();
+
 	/** Called when the controlled VR character becomes stunned. */
 	UFUNCTION(BlueprintImplementableEvent, Category = EmpathPlayerController, meta = (DisplayName = "OnCharacterStunned"))
 	void ReceiveCharacterStunned(const AController* StunInstigator, const AActor* StunCauser, const float StunDuration);
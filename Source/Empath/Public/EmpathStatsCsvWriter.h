@@ -0,0 +1,49 @@
+// Copyright 2018 Team Empath All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Writes per-frame timings and the values of any active stat groups to a CSV file, one row per stat per frame.
+* Groups are picked up from the game thread stats data, so they need to be enabled (ie: "stat EMPATH_Character") to be written.
+* Rows are in the form Frame,Group,Stat,Value so captures with different active groups can still be diffed.
+* A capture can also be started and stopped from the console with Empath.StatsCsv 1/0.
+*/
+class EMPATH_API FEmpathStatsCsvWriter
+{
+public:
+	FEmpathStatsCsvWriter();
+	~FEmpathStatsCsvWriter();
+
+	/** Opens a new CSV file, closing any previous one. Relative paths are placed in the project's Saved/Profiling folder. */
+	bool Open(const FString& FileName);
+
+	/** Flushes and closes the current file. */
+	void Close();
+
+	/** Whether we currently have a file open. */
+	bool IsOpen() const { return CsvArchive != nullptr; }
+
+	/** Returns the full path of the current file. */
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Writes the timings for the current frame. */
+	void WriteFrame(float DeltaTime);
+
+	/** Whether a stat group (the name used by the stat command) is currently active in the game thread stats data. */
+	static bool IsStatGroupActive(FName const StatGroup);
+
+private:
+	/** The file we are writing to. */
+	FArchive* CsvArchive;
+
+	/** Full path of the file we are writing to. */
+	FString FilePath;
+
+	/** Number of frames written since the file was opened. */
+	uint32 FramesWritten;
+
+	/** Appends a row to the file. */
+	void WriteRow(const TCHAR* Group, const FString& Stat, double Value);
+};
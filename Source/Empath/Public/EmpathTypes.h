@@ -163,6 +163,37 @@ enum class EEmpathCharacterPhysicsState : uint8
 	GettingUp,
 };
 
+UENUM(BlueprintType)
+enum class EEmpathRagdollLODState : uint8
+{
+	/** Ragdoll is fully simulating. */
+	Simulating,
+
+	/** Ragdoll is held kinematic in its last simulated pose. */
+	Frozen,
+
+	/** Ragdoll is held in its frozen pose and the mesh no longer has collision or ticks. */
+	PoseSnapshot,
+};
+
+USTRUCT(BlueprintType)
+struct FEmpathCharacterPoolPrewarm
+{
+	GENERATED_USTRUCT_BODY();
+
+	/** The class of character to pre-spawn into the character pool. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSubclassOf<class AEmpathCharacter> CharacterClass;
+
+	/** How many characters of this class to pre-spawn into the character pool when the level loads. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (UIMin = 0, ClampMin = 0))
+	int32 Count;
+
+	FEmpathCharacterPoolPrewarm()
+		: Count(0)
+	{}
+};
+
 USTRUCT(BlueprintType)
 struct FEmpathCharPhysicsStateSettings
 {
@@ -207,6 +238,58 @@ struct FEmpathCharPhysicsStateSettingsEntry
 	FEmpathCharPhysicsStateSettings Settings;
 };
 
+/** A physics state preset resolved against the bodies and constraints of a physics asset. Arrays are indexed the same as the physics asset. */
+struct FEmpathResolvedPhysicsState
+{
+public:
+
+	/** Whether the character has settings for this state. */
+	bool bHasSettings;
+
+	/** The settings this state was resolved from. */
+	FEmpathCharPhysicsStateSettings Settings;
+
+	/** Simulate flag for each body, or -1 if this state leaves the body as it is. */
+	TArray<int8> BodySimulate;
+
+	/** Gravity flag for each body. */
+	TArray<bool> BodyGravity;
+
+	/** Physical animation profile found for each body, or NAME_None if it is cleared. Only used where BodyDriveSet is true. */
+	TArray<FName> BodyDriveProfile;
+	TArray<bool> BodyDriveSet;
+
+	/** Constraint profile for each constraint. Only used where ConstraintProfileSet is true. */
+	TArray<FName> ConstraintProfile;
+	TArray<bool> ConstraintProfileSet;
+
+	FEmpathResolvedPhysicsState()
+		: bHasSettings(false)
+	{}
+};
+
+/** The bodies and constraints that need updating when moving between two resolved physics states. */
+struct FEmpathPhysicsStateTransition
+{
+public:
+
+	TArray<int32> SimulateBodies;
+	TArray<int32> GravityBodies;
+	TArray<int32> Constraints;
+	bool bPhysicalAnimationChanged;
+
+	/** A changed body whose whole subtree ends up with the same simulate flag. Simulation is reapplied below it through the mesh 
+	* so the mesh updates its root body and physics ticks. NAME_None if there is no such body and the transition must be applied in full. */
+	FName SimulateRootBoneName;
+	bool bSimulateRootBoneValue;
+
+	FEmpathPhysicsStateTransition()
+		: bPhysicalAnimationChanged(false),
+		SimulateRootBoneName(NAME_None),
+		bSimulateRootBoneValue(false)
+	{}
+};
+
 struct FEmpathVelocityFrame
 {
 public:
@@ -222,6 +305,77 @@ public:
 	{}
 };
 
+/** A single key or axis event captured by the input recorder. Keys are stored as an index into the recording's key name table. */
+struct FEmpathRecordedInputEvent
+{
+public:
+
+	uint16 KeyIndex;
+	uint8 EventType;	// EInputEvent, or AxisEventType for axis input
+	bool bGamepad;
+	float Value;
+	float AxisDeltaTime;
+	int32 NumSamples;
+
+	static const uint8 AxisEventType = 0xFF;
+
+	FEmpathRecordedInputEvent()
+		: KeyIndex(0),
+		EventType(AxisEventType),
+		bGamepad(false),
+		Value(0.0f),
+		AxisDeltaTime(0.0f),
+		NumSamples(0)
+	{}
+
+	friend FArchive& operator<<(FArchive& Ar, FEmpathRecordedInputEvent& Event)
+	{
+		Ar << Event.KeyIndex << Event.EventType << Event.bGamepad << Event.Value;
+
+		// Only axis events need the sample data
+		if (Event.EventType == AxisEventType)
+		{
+			Ar << Event.AxisDeltaTime << Event.NumSamples;
+		}
+		return Ar;
+	}
+};
+
+/** One frame of recorded VR input. Tracked transforms are relative to the pawn, as they would come from the tracking system. */
+struct FEmpathRecordedInputFrame
+{
+public:
+
+	float DeltaTime;
+	FVector HMDLocation;
+	FQuat HMDRotation;
+	FVector LeftHandLocation;
+	FQuat LeftHandRotation;
+	FVector RightHandLocation;
+	FQuat RightHandRotation;
+	TArray<FEmpathRecordedInputEvent> Events;
+
+	FEmpathRecordedInputFrame()
+		: DeltaTime(0.0f),
+		HMDLocation(FVector::ZeroVector),
+		HMDRotation(FQuat::Identity),
+		LeftHandLocation(FVector::ZeroVector),
+		LeftHandRotation(FQuat::Identity),
+		RightHandLocation(FVector::ZeroVector),
+		RightHandRotation(FQuat::Identity)
+	{}
+
+	friend FArchive& operator<<(FArchive& Ar, FEmpathRecordedInputFrame& Frame)
+	{
+		Ar << Frame.DeltaTime;
+		Ar << Frame.HMDLocation << Frame.HMDRotation;
+		Ar << Frame.LeftHandLocation << Frame.LeftHandRotation;
+		Ar << Frame.RightHandLocation << Frame.RightHandRotation;
+		Ar << Frame.Events;
+		return Ar;
+	}
+};
+
 namespace EmpathNavAreaFlags
 {
 	const int16 Navigable = (1 << 1);		// this one is defined by the system